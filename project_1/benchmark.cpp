@@ -0,0 +1,282 @@
+#include <vector>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "utils.hpp"
+#include "tridiagonal_algorithms.hpp"
+#include "parallel_tridiagonal.hpp"
+#include "toeplitz_solver.hpp"
+#include "dst_poisson.hpp"
+
+#ifdef USE_LAPACK
+extern "C" void dgtsv_(const int *n, const int *nrhs, double *dl, double *d, double *du,
+                       double *b, const int *ldb, int *info);
+#endif
+
+/**
+ * One algorithm to benchmark. `prepare(n, k)` sets up the inputs of the k'th call
+ * (outside of the timed region), and `run(n, k)` does the k'th call.
+ */
+struct Path
+{
+    std::string name;
+    double bytes_per_element;   // Estimated doubles read + written per unknown, times 8
+    std::function<void(int, int)> prepare;
+    std::function<void(int, int)> run;
+};
+
+struct Result
+{
+    std::string name;
+    int n;
+    int calls_per_trial;
+    double median;      // Time per call [s]
+    double min;
+    double max;
+    double mad;         // Median absolute deviation [s]
+};
+
+double median_of(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    int m = values.size();
+    return (m % 2 == 1) ? values[m / 2] : 0.5 * (values[m / 2 - 1] + values[m / 2]);
+}
+
+Result benchmark(Path &path, int n, int n_trials, int n_warmup)
+{
+    // Enough calls per trial to get well above the resolution of the clock:
+    int calls = std::max(1, 1000000 / n);
+
+    for (int k = 0; k < calls; k++)
+    {
+        path.prepare(n, k);
+    }
+    for (int trial = 0; trial < n_warmup; trial++)
+    {
+        path.run(n, 0);
+        path.prepare(n, 0);
+    }
+
+    std::vector<double> times(n_trials);
+
+    for (int trial = 0; trial < n_trials; trial++)
+    {
+        for (int k = 0; k < calls; k++)
+        {
+            path.prepare(n, k);
+        }
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        for (int k = 0; k < calls; k++)
+        {
+            path.run(n, k);
+        }
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        times[trial] = std::chrono::duration<double>(t2 - t1).count() / calls;
+    }
+
+    Result result;
+    result.name = path.name;
+    result.n = n;
+    result.calls_per_trial = calls;
+    result.median = median_of(times);
+    result.min = *std::min_element(times.begin(), times.end());
+    result.max = *std::max_element(times.begin(), times.end());
+
+    std::vector<double> deviations(n_trials);
+    for (int trial = 0; trial < n_trials; trial++)
+    {
+        deviations[trial] = std::abs(times[trial] - result.median);
+    }
+    result.mad = median_of(deviations);
+
+    return result;
+}
+
+void write_json(const std::vector<Result> &results, const std::vector<Path> &paths, std::string filename)
+{
+    std::ofstream ofile;
+    ofile.open(filename);
+
+    ofile << "[\n";
+    for (int i = 0; i < results.size(); i++)
+    {
+        const Result &r = results[i];
+        double bytes = 0;
+        for (const Path &path : paths)
+        {
+            if (path.name == r.name)
+            {
+                bytes = path.bytes_per_element;
+            }
+        }
+
+        ofile << std::setprecision(6) << std::scientific
+              << "  {\"algorithm\": \"" << r.name << "\""
+              << ", \"n\": " << r.n
+              << ", \"calls_per_trial\": " << r.calls_per_trial
+              << ", \"median_s\": " << r.median
+              << ", \"min_s\": " << r.min
+              << ", \"max_s\": " << r.max
+              << ", \"mad_s\": " << r.mad
+              << ", \"ns_per_element\": " << 1e9 * r.median / r.n
+              << ", \"GB_per_s\": " << 1e-9 * bytes * r.n / r.median
+              << "}" << ((i + 1 < results.size()) ? "," : "") << "\n";
+    }
+    ofile << "]\n";
+
+    ofile.close();
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 4)
+    {
+        std::string executable_name = argv[0];
+        std::cerr << "Error: Wrong number of input arguments.\n";
+        std::cerr << "Usage: " << executable_name << " <max power of 10> <trials> <filename>\n";
+        return 1;
+    }
+
+    int max_power = std::stoi(argv[1]);
+    int n_trials = std::stoi(argv[2]);
+    std::string filename = argv[3];
+    const int n_warmup = 2;
+
+    // The solvers take the size as an int, so n = 10^p must fit in one:
+    if (max_power < 1 || max_power > 9)
+    {
+        std::cerr << "Error: The max power of 10 must be between 1 and 9.\n";
+        return 1;
+    }
+    if (n_trials < 1)
+    {
+        std::cerr << "Error: The number of trials must be at least 1.\n";
+        return 1;
+    }
+    const int n_threads = std::thread::hardware_concurrency();
+
+    // Inputs are shared between paths, buffers for in-place algorithms are one per call:
+    std::vector<double> a, b, c, g;
+    std::vector<std::vector<double>> buffers;
+    std::vector<std::vector<double>> dl, d, du;
+    std::vector<double> workspace;
+    std::vector<double> solution;
+    ToeplitzSolver<double> toeplitz(-1.0, 2.0, -1.0, 1);
+    std::unique_ptr<DSTPoissonSolver> dst;
+
+    auto ensure = [&](std::vector<std::vector<double>> &vectors, int k, int n) {
+        if (vectors.size() <= k)
+        {
+            vectors.resize(k + 1);
+        }
+        vectors[k].resize(n);
+    };
+
+    auto copy_rhs = [&](int n, int k) {
+        ensure(buffers, k, n);
+        std::copy(g.begin(), g.begin() + n, buffers[k].begin());
+    };
+
+    std::vector<Path> paths;
+
+    paths.push_back({"general", 8 * 10.0, [](int, int) {},
+                     [&](int /*n*/, int) { solution = general_algorithm(a, b, c, g); }});
+
+    paths.push_back({"special", 8 * 6.0, [](int, int) {},
+                     [&](int /*n*/, int) { solution = special_algorithm(g); }});
+
+    paths.push_back({"general_inplace", 8 * 10.0, copy_rhs,
+                     [&](int n, int k) { general_algorithm(a.data(), b.data(), c.data(), buffers[k].data(), n, workspace.data()); }});
+
+    paths.push_back({"special_inplace", 8 * 4.0, copy_rhs,
+                     [&](int n, int k) { special_algorithm(buffers[k].data(), n); }});
+
+    paths.push_back({"toeplitz", 8 * 4.0, copy_rhs,
+                     [&](int /*n*/, int k) { toeplitz.solve(buffers[k].data()); }});
+
+    // Two complex FFTs of length 2(n + 1), i.e. O(n log n) rather than memory bound:
+    paths.push_back({"dst", 8 * 2.0, copy_rhs,
+                     [&](int /*n*/, int k) { dst->solve(buffers[k].data()); }});
+
+    paths.push_back({"parallel", 8 * 17.0, copy_rhs,
+                     [&](int n, int k) { parallel_general_algorithm(a.data(), b.data(), c.data(), buffers[k].data(), n, workspace.data(), n_threads); }});
+
+#ifdef USE_LAPACK
+    // dgtsv overwrites the diagonals as well, so those need fresh copies for every call:
+    paths.push_back({"dgtsv", 8 * 12.0,
+                     [&](int n, int k) {
+                         copy_rhs(n, k);
+                         ensure(dl, k, n - 1);
+                         ensure(d, k, n);
+                         ensure(du, k, n - 1);
+                         std::copy(a.begin(), a.end(), dl[k].begin());
+                         std::copy(b.begin(), b.end(), d[k].begin());
+                         std::copy(c.begin(), c.end(), du[k].begin());
+                     },
+                     [&](int n, int k) {
+                         int nrhs = 1;
+                         int info;
+                         dgtsv_(&n, &nrhs, dl[k].data(), d[k].data(), du[k].data(), buffers[k].data(), &n, &info);
+                     }});
+#endif
+
+    std::vector<Result> results;
+
+    std::cout << std::left << std::setw(18) << "algorithm" << std::setw(12) << "n"
+              << std::setw(14) << "median [s]" << std::setw(14) << "mad [s]"
+              << std::setw(14) << "ns/element" << "GB/s\n";
+
+    for (int p = 1; p <= max_power; p++)
+    {
+        int n = static_cast<int>(std::pow(10, p));
+        double h = 1.0 / (n + 1);
+
+        // Same system as in thomas_algorithm.cpp:
+        a.assign(n - 1, -1.0);
+        b.assign(n, 2.0);
+        c.assign(n - 1, -1.0);
+        g.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            g[i] = h * h * source_term((i + 1) * h);
+        }
+        workspace.resize(2 * n);
+        toeplitz = ToeplitzSolver<double>(-1.0, 2.0, -1.0, n);
+        dst = std::make_unique<DSTPoissonSolver>(n);
+
+        for (Path &path : paths)
+        {
+            Result r = benchmark(path, n, n_trials, n_warmup);
+            results.push_back(r);
+
+            std::cout << std::left << std::setw(18) << r.name << std::setw(12) << r.n
+                      << std::setprecision(4) << std::scientific
+                      << std::setw(14) << r.median << std::setw(14) << r.mad
+                      << std::setprecision(3) << std::fixed
+                      << std::setw(14) << 1e9 * r.median / n
+                      << 1e-9 * path.bytes_per_element * n / r.median << "\n";
+        }
+
+        // Free the per-call buffers before moving on to a larger n:
+        buffers.clear();
+        dl.clear();
+        d.clear();
+        du.clear();
+    }
+
+    write_json(results, paths, filename);
+    std::cout << "Results written to " << filename << "\n";
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <vector>
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include <chrono>
+#include <algorithm>
+
+#include "arg_parser.hpp"
+#include "output_writer.hpp"
+#include "diffusion.hpp"
+
+/**
+ * `<stem>_<time step><extension>`, e.g. rod_100.bin for rod.bin.
+ */
+std::string snapshot_filename(const std::string &filename, int time_step)
+{
+    std::size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos)
+    {
+        return filename + "_" + std::to_string(time_step);
+    }
+    return filename.substr(0, dot) + "_" + std::to_string(time_step) + filename.substr(dot);
+}
+
+void write_snapshot(const Args &args, const std::vector<double> &u, double h, int time_step)
+{
+    int steps = args.n_steps;
+    OutputWriter writer(snapshot_filename(args.filename, time_step), decimation_stride(steps + 1, args.n_points));
+    writer.write(0, 0);
+    for (int i = 0; i < steps - 1; i++)
+    {
+        writer.write((i + 1) * h, u[i]);
+    }
+    writer.write(1, 0);
+    writer.close();
+}
+
+/**
+ * Solves the diffusion equation u_t = u_xx on [0, 1] with u = 0 at both ends and u(x, 0) = sin(pi x),
+ * whose solution is exp(-pi^2 t) sin(pi x), with the theta scheme. Snapshots are written every
+ * --snapshot-every time steps, and the time per step and the final max error are printed.
+ */
+int main(int argc, char *argv[])
+{
+    Args args = parse_args(argc, argv);
+
+    int steps = args.n_steps;           // (no. of steps in space)
+    const double h = 1.0 / steps;
+    const double dt = (args.dt > 0) ? args.dt : h;
+    int n = steps - 1;                  // ( the boundaries are not included )
+
+    std::vector<double> u(n);
+    for (int i = 0; i < n; i++)
+    {
+        u[i] = std::sin(M_PI * (i + 1) * h);
+    }
+
+    ThetaScheme scheme(n, dt / (h * h), args.theta);
+
+    double seconds = 0;
+    for (int k = 1; k <= args.time_steps; k++)
+    {
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        scheme.step(u.data());
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        seconds += std::chrono::duration<double>(t2 - t1).count();
+
+        if ((args.snapshot_every > 0 && k % args.snapshot_every == 0) || k == args.time_steps)
+        {
+            try
+            {
+                write_snapshot(args, u, h, k);
+            }
+            catch (const std::runtime_error &error)
+            {
+                std::cerr << "Error: " << error.what() << "\n";
+                exit(1);
+            }
+        }
+    }
+
+    double t = args.time_steps * dt;
+    double max_error = 0;
+    for (int i = 0; i < n; i++)
+    {
+        max_error = std::max(max_error, std::abs(u[i] - std::exp(-M_PI * M_PI * t) * std::sin(M_PI * (i + 1) * h)));
+    }
+
+    std::cout << "Time per step: " << seconds / args.time_steps << " s (" << 1e9 * seconds / args.time_steps / n << " ns per point)\n";
+    std::cout << "Max error at t = " << t << ": " << max_error << "\n";
+
+    return 0;
+}
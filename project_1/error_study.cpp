@@ -0,0 +1,45 @@
+#include <vector>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <iomanip>
+#include <iostream>
+
+#include "arg_parser.hpp"
+#include "convergence.hpp"
+
+int main(int argc, char *argv[])
+{
+    Args args = parse_args(argc, argv);
+
+    // n_steps = 10, 100, ..., up to the given step number:
+    std::vector<int> n_steps;
+    for (long long n = 10; n <= args.n_steps; n *= 10)
+    {
+        n_steps.push_back(n);
+    }
+
+    std::vector<ErrorNorms> errors = error_study(n_steps, args.n_threads);
+
+    std::ofstream ofile;
+    ofile.open(args.filename);
+    ofile << "n_steps,max_abs_error,max_rel_error,seconds\n";
+
+    std::cout << std::left << std::setw(14) << "n_steps" << std::setw(16) << "max(Delta)"
+              << std::setw(16) << "max(epsilon)" << "time [s]\n";
+
+    for (const ErrorNorms &e : errors)
+    {
+        ofile << e.n_steps << std::setprecision(14) << std::scientific
+              << "," << e.max_abs_error << "," << e.max_rel_error << "," << e.seconds << "\n";
+
+        std::cout << std::left << std::setw(14) << e.n_steps << std::setprecision(6) << std::scientific
+                  << std::setw(16) << e.max_abs_error << std::setw(16) << e.max_rel_error
+                  << std::setprecision(3) << e.seconds << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+        ofile.unsetf(std::ios::floatfield);
+    }
+    ofile.close();
+
+    return 0;
+}
@@ -4,38 +4,42 @@
 #include <string>
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
 
 #include "utils.hpp"
+#include "arg_parser.hpp"
+#include "output_writer.hpp"
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
-    {
-        std::string executable_name = argv[0];
-        std::cerr << "Error: Wrong number of input arguments.\n;";
-        std::cerr << "Usage: " << executable_name << " <step number> <filename>\n";
-        return 1;
-    }
-    
-    int n_steps = atoi(argv[1]);
-    std::string filename = argv[2];
+    Args args = parse_args(argc, argv);
+
+    int n_steps = args.n_steps;
+    std::string filename = args.filename;
+    long long n_points = args.n_points;     // (0 means all points)
     const double x0 = 0.0;
     const double x1 = 1.0;
     const double h  = (x1 - x0) / n_steps;
 
-    std::vector<double> x_vector(n_steps + 1);
-    std::vector<double> u_vector(n_steps + 1);
-    x_vector[0] = x0;
-    u_vector[0] = exact_solution(x0);
+    // Evaluate and write point by point, so no vectors of size n_steps + 1 are needed:
+    try
+    {
+        OutputWriter writer(filename, decimation_stride(n_steps + 1, n_points));
+        double x = x0;
+        writer.write(x, exact_solution(x));
 
-    for (int i = 1; i <= n_steps; i++)
+        for (int i = 1; i <= n_steps; i++)
+        {
+            x = x + h;
+            writer.write(x, exact_solution(x));
+        }
+        writer.close();
+    }
+    catch (const std::runtime_error &error)
     {
-        x_vector[i] = x_vector[i - 1] + h;
-        u_vector[i] = exact_solution(x_vector[i]);
+        std::cerr << "Error: " << error.what() << "\n";
+        exit(1);
     }
 
-
-    write_to_file(x_vector, u_vector, filename);
-
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+
+#ifndef __adi_hpp__
+#define __adi_hpp__
+
+#include <vector>
+#include <thread>
+
+/**
+ * Alternating direction implicit (Peaceman-Rachford) solver on an (nx x ny) grid with
+ * homogeneous Dirichlet boundaries, for the same 2D operator as DSTPoissonSolver:
+ * A = I (x) A_x + A_y (x) I with (-1, 2, -1) matrices A_x and A_y. Every half step solves
+ * one tridiagonal system per grid line, implicitly in one direction and explicitly in the other:
+ *   (rho + A_x) v* = g + (rho - A_y) v       (ny lines along x)
+ *   (rho + A_y) v' = g + (rho - A_x) v*      (nx lines along y)
+ *
+ * The lines are solved in batches of `lanes` neighbouring lines with
+ * TridiagonalFactorization::solve_many, whose inner loop runs across the lines and vectorizes.
+ * For this the grid is kept in two tiled layouts: for the x-sweep, tiles of `lanes` rows
+ * stored interleaved (entry (i, j) of the tile at [i * lanes + j]), and for the y-sweep,
+ * tiles of `lanes` columns in the same way. A tile (about 128 kB for a 1000-point line) stays
+ * in cache through both the sweep and the explicit part of the next half step. Switching
+ * layouts only transposes contiguous (lanes x lanes) blocks. The tiles are spread across threads,
+ * which are started once per solve and wait at a barrier between the sweeps.
+ *
+ * Grids given to and returned from the solver are row-major, entry (i, j) at [j * nx + i].
+ */
+class ADISolver
+{
+private:
+    int nx, ny;
+    int n_threads;
+    int tiles_x, tiles_y;               // Number of tiles of the x- and y-layout
+
+    std::vector<double> g_x, g_y;       // Right hand side in the x- and y-layout
+    std::vector<double> v_y;            // Current solution, y-layout
+    std::vector<double> rhs_x, rhs_y;   // Right hand sides of the next y- and x-sweep
+
+    void to_layouts(const double *g, const double *v);
+    void from_layout(double *v) const;
+    int iterate(const std::vector<double> &shifts, int max_iterations, double tolerance);
+
+public:
+    static constexpr int lanes = 16;    // Number of lines per tile
+
+    /**
+     * @param nx Number of unknowns in x
+     * @param ny Number of unknowns in y
+     * @param n_threads Number of threads (defaults to the number of available cores)
+     */
+    ADISolver(int nx, int ny, int n_threads = std::thread::hardware_concurrency());
+
+    /**
+     * Solves the Poisson problem Av = g by ADI iteration. The shifts rho cycle through a
+     * geometric sequence spanning the eigenvalues of A_x and A_y, which converges in
+     * O(log n) iterations per digit instead of the O(n) of a single shift.
+     * @param g Right hand side h^2 f (row-major, length nx * ny)
+     * @param v Initial guess on input, solution on output (row-major, length nx * ny)
+     * @param tolerance Stop when the change of v over a cycle of shifts is at most tolerance * max |v|
+     * @param max_iterations Maximum number of (full) iterations
+     * @return Number of iterations done
+     */
+    int poisson(const double *g, double *v, double tolerance = 1e-10, int max_iterations = 1000);
+
+    /**
+     * Time steps the diffusion equation u_t = u_xx + u_yy with the Peaceman-Rachford scheme,
+     * which is second order in time and unconditionally stable. This is the iteration above
+     * with g = 0 and the constant shift rho = 2/r.
+     * @param v Initial state on input, state after n_steps steps on output (row-major, length nx * ny)
+     * @param r dt/h^2
+     * @param n_steps Number of time steps
+     */
+    void diffusion(double *v, double r, int n_steps);
+};
+
+#endif
@@ -0,0 +1,38 @@
+
+#ifndef __arg_parser_hpp__
+#define __arg_parser_hpp__
+
+#include <string>
+#include <iostream>
+#include <thread>
+
+/**
+ * Struct to hold the command-line arguments of the main programs.
+ */
+struct Args
+{
+    long long n_steps = 0;      ///< Number of steps in the FULL solution (first positional argument).
+    std::string filename;       ///< Output file, binary if it ends with `.bin` (second positional argument).
+    long long n_points = 0;     ///< Decimate the output to about this many points (0 means all points).
+    bool stream = false;        ///< Use the streaming solver, which evaluates the source term inside the sweep.
+    bool numerov = false;       ///< Use the fourth order (Numerov) right hand side instead of h^2 f(x_i).
+    bool dst = false;           ///< Use the discrete sine transform (DST) Poisson solver instead of the Thomas algorithm.
+    double tolerance = 0;       ///< Solve on an adaptive nonuniform mesh to this max relative error (0 means uniform mesh).
+    bool out_of_core = false;   ///< Use the out-of-core solver, which keeps the vectors in memory-mapped files.
+    double dt = 0;              ///< Time step of the diffusion program (0 means dt = h).
+    int time_steps = 100;       ///< Number of time steps of the diffusion program.
+    double theta = 0.5;         ///< Implicitness of the diffusion program (1/2 is Crank-Nicolson, 1 backward Euler).
+    int snapshot_every = 0;     ///< Write a snapshot every this many time steps (0 means only the final state).
+    int n_threads = std::thread::hardware_concurrency();  ///< Number of threads, where supported.
+    std::string precision = "double";   ///< Scalar type of the solvers: float, double or long_double.
+};
+
+/**
+ * Parses `<step number> <filename> [options]`. Prints the usage and exits on invalid input.
+ * @param argc Number of command-line arguments
+ * @param argv Array of command-line argument strings
+ * @return Args struct containing the parsed values
+ */
+Args parse_args(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,52 @@
+
+#ifndef __convergence_hpp__
+#define __convergence_hpp__
+
+#include <vector>
+#include <thread>
+
+/**
+ * Maximum errors of a numerical solution v compared to the exact solution u,
+ * taken over the interior points.
+ */
+struct ErrorNorms
+{
+    int n_steps;                // Number of steps of the solution
+    double max_abs_error;       // max |v_i - u_i|
+    double max_rel_error;       // max |(v_i - u_i)/u_i|
+    double seconds;             // Time spent on the solve (including the error reduction)
+};
+
+/**
+ * Evaluates exp(k x_i) on the grid x_i = x_start + i h, i = 0, ..., count - 1.
+ * Only one call to std::exp is done per block of 64 points; the rest are multiplications
+ * with a table of exp(k i h), which vectorize. The result is accurate to a few ulp.
+ * @param k Coefficient in the exponent
+ * @param x_start First grid point
+ * @param h Step length
+ * @param count Number of points
+ * @param out Result (length count)
+ */
+void exp_grid(double k, double x_start, double h, int count, double *out);
+
+/**
+ * Solves the Poisson problem of this project (see `source_term` and `exact_solution`)
+ * with the streaming special algorithm, and computes the errors as reductions during
+ * the backward sweep, using exp_grid for the exact solution.
+ * @param n_steps Number of steps
+ * @param v Workspace, holds the solution including boundaries on output (length n_steps + 1)
+ * @return Maximum absolute and relative errors
+ */
+ErrorNorms special_algorithm_errors(int n_steps, double *v);
+
+/**
+ * Runs special_algorithm_errors for every number of steps in `n_steps`, with the
+ * different sizes running concurrently (largest first) on `n_threads` threads.
+ * @param n_steps Numbers of steps to run
+ * @param n_threads Number of threads
+ * @return Errors, in the same order as `n_steps`
+ */
+std::vector<ErrorNorms> error_study(const std::vector<int> &n_steps,
+                                    int n_threads = std::thread::hardware_concurrency());
+
+#endif
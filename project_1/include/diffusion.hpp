@@ -0,0 +1,40 @@
+
+#ifndef __diffusion_hpp__
+#define __diffusion_hpp__
+
+#include "toeplitz_solver.hpp"
+
+/**
+ * Theta scheme for the diffusion equation u_t = u_xx with u = 0 at both ends, on n interior
+ * points with r = dt/h^2:
+ *   (I + theta r A) u^{k+1} = (I - (1 - theta) r A) u^k,
+ * where A is the (-1, 2, -1) matrix. theta = 1 is backward Euler and theta = 1/2 Crank-Nicolson,
+ * both unconditionally stable, so large time steps can be used.
+ *
+ * The implicit matrix is constant, so it is factorized once in the constructor (a ToeplitzSolver,
+ * which only stores the few pivots before they converge). A step then applies the explicit
+ * matrix in place and solves in place, i.e. three passes over u and no copies.
+ */
+class ThetaScheme
+{
+private:
+    int n;
+    double alpha, beta;                 // Explicit matrix I - (1 - theta) r A = (alpha, beta, alpha)
+    ToeplitzSolver<double> implicit;    // Implicit matrix I + theta r A
+
+public:
+    /**
+     * @param n Number of interior points
+     * @param r dt/h^2
+     * @param theta Implicitness, from 0 (forward Euler) to 1 (backward Euler)
+     */
+    ThetaScheme(int n, double r, double theta);
+
+    /**
+     * Takes one time step in place.
+     * @param u Solution at the interior points, at time t on input and t + dt on output (length n)
+     */
+    void step(double *u) const;
+};
+
+#endif
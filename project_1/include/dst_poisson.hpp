@@ -0,0 +1,83 @@
+
+#ifndef __dst_poisson_hpp__
+#define __dst_poisson_hpp__
+
+#include <vector>
+
+#include "fft.hpp"
+
+/**
+ * Discrete sine transform (DST-I) of a fixed length n,
+ *   X_k = sum_{j=1}^{n} x_j sin(pi jk/(n + 1)),   k = 1, ..., n.
+ * Applying it twice gives back (n + 1)/2 times the input.
+ *
+ * X is read off the FFT of the odd extension (0, x, 0, -reversed x) of length 2(n + 1). Since
+ * the extension is real, its even and odd entries are packed as the real and imaginary parts
+ * of a complex sequence, so only an FFT of length n + 1 is needed. This is a power of two for
+ * the "natural" sizes n = 2^k - 1.
+ */
+class SineTransform
+{
+private:
+    int n;
+    FFT fft;
+    std::vector<std::complex<double>> twiddles;     // exp(-pi i k/(n + 1)), k <= n
+
+public:
+    /**
+     * @param n Length of the transform
+     */
+    SineTransform(int n);
+
+    /**
+     * Transforms x in place.
+     * @param x Sequence x_1, ..., x_n (length n)
+     */
+    void transform(double *x) const;
+};
+
+/**
+ * Direct Poisson solver with homogeneous Dirichlet boundaries, using that the discrete sine
+ * transform diagonalizes the (-1, 2, -1) matrix: its eigenvalues are
+ *   mu_k = 2 - 2cos(pi k/(n + 1)) = 4 sin^2(pi k/(2(n + 1))),   k = 1, ..., n,
+ * with sine eigenvectors. A solve is a DST, a division by the eigenvalues and another DST.
+ *
+ * - 1D (ny = 1): Av = g with A the (nx x nx) matrix (-1, 2, -1), the same system as the
+ *   special algorithm.
+ * - 2D: the 5-point Laplacian on an (nx x ny) grid with equal step lengths h, i.e.
+ *   A = I (x) A_x + A_y (x) I with (-1, 2, -1) matrices A_x and A_y, and g = h^2 f. The grid is
+ *   stored row-major, entry (i, j) at g[j * nx + i]. The DSTs run over the rows, and over the
+ *   columns by transposing in cache-sized blocks in between.
+ *
+ * The cost is O(N log N) for N unknowns, for any nx and ny (not only powers of two).
+ */
+class DSTPoissonSolver
+{
+private:
+    int nx, ny;
+    SineTransform dst_x, dst_y;
+    std::vector<double> inv_eigenvalues;    // Including the DST normalization (transposed in 2D: [i * ny + j])
+
+public:
+    /**
+     * Sets up the transforms and eigenvalues.
+     * @param nx Number of unknowns in x
+     * @param ny Number of unknowns in y (1 for the 1D problem)
+     */
+    DSTPoissonSolver(int nx, int ny = 1);
+
+    /**
+     * Solves Av = g in place.
+     * @param g Right hand side on input, solution (without boundaries) on output (length nx * ny)
+     */
+    void solve(double *g) const;
+
+    /**
+     * Solves Av = g.
+     * @param g Right hand side (length nx * ny)
+     * @return Solution vector v, without boundaries (length nx * ny)
+     */
+    std::vector<double> solve(std::vector<double> g) const;
+};
+
+#endif
@@ -0,0 +1,56 @@
+
+#ifndef __fft_hpp__
+#define __fft_hpp__
+
+#include <vector>
+#include <complex>
+#include <memory>
+
+/**
+ * Complex discrete Fourier transform of a fixed length n,
+ *   X_k = sum_j x_j exp(-2 pi i jk/n),   j, k = 0, ..., n - 1.
+ *
+ * Powers of two use an iterative radix-2 FFT with tabulated twiddle factors and bit
+ * reversal. Other lengths use Bluestein's algorithm, which writes the transform as a
+ * convolution and evaluates it with a power-of-two FFT of length m >= 2n - 1.
+ * Either way the cost is O(n log n), and all tables are set up in the constructor.
+ */
+class FFT
+{
+private:
+    int n;
+    bool power_of_two;
+
+    // Radix-2:
+    std::vector<int> bit_reversed;
+    std::vector<std::complex<double>> twiddles;     // exp(-pi i k/half) at [half + k], k < half
+
+    // Bluestein:
+    std::vector<std::complex<double>> chirp;        // exp(-pi i k^2/n), k < n
+    std::vector<std::complex<double>> chirp_filter; // Transform of the conjugate chirp, length m
+    std::unique_ptr<FFT> inner;                     // Power-of-two FFT of length m
+
+    void butterflies(std::complex<double> *x, int count, int length) const;
+    void radix2(std::complex<double> *x) const;
+    void bluestein(std::complex<double> *x) const;
+
+public:
+    /**
+     * Sets up the tables for transforms of length n.
+     * @param n Length of the transform (n >= 1)
+     */
+    FFT(int n);
+
+    /**
+     * @return Length of the transform
+     */
+    int size() const;
+
+    /**
+     * Forward transform in place.
+     * @param x Input on entry, transform on exit (length n)
+     */
+    void transform(std::complex<double> *x) const;
+};
+
+#endif
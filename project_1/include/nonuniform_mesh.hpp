@@ -0,0 +1,60 @@
+
+#ifndef __nonuniform_mesh_hpp__
+#define __nonuniform_mesh_hpp__
+
+#include <vector>
+
+/**
+ * Solves -(p(x) u'(x))' = f(x) on the mesh x_0 < x_1 < ... < x_N with u(x_0) = u(x_N) = 0.
+ * With h_i = x_{i+1} - x_i, the three-point (finite volume) discretization at x_i is
+ *   -p_{i+1/2} (u_{i+1} - u_i)/h_i + p_{i-1/2} (u_i - u_{i-1})/h_{i-1} = f(x_i) (h_{i-1} + h_i)/2,
+ * with p_{i+1/2} = p((x_i + x_{i+1})/2). This is a symmetric tridiagonal system, solved with
+ * the in-place general algorithm. For a uniform mesh and p = 1 it is the usual (-1, 2, -1) scheme.
+ * @param x Mesh, including the boundaries (length N + 1)
+ * @param p Coefficient p(x) > 0
+ * @param f Source term f(x)
+ * @return Solution at the mesh points, including the boundaries (length N + 1)
+ */
+std::vector<double> nonuniform_algorithm(const std::vector<double> &x,
+                                         double (*p)(double),
+                                         double (*f)(double));
+
+/**
+ * Result of adaptive_algorithm.
+ */
+struct AdaptiveSolution
+{
+    std::vector<double> x;      // Final mesh, including the boundaries
+    std::vector<double> u;      // Solution on the final mesh
+    double estimated_error;     // Estimated max relative error over the interior points
+    int refinements;            // Number of refinement steps done
+};
+
+/**
+ * Solves -(p u')' = f on [x0, x1] with u(x0) = u(x1) = 0 on an adaptively refined mesh.
+ *
+ * Starting from a uniform mesh, each step solves on the mesh and on its bisection. Their
+ * difference gives an a posteriori (Richardson) estimate of the nodal errors,
+ * |u_{h/2} - u| ~ |u_h - u_{h/2}|/3, and so of the max relative error. If it is above the
+ * tolerance, a new mesh is made with the number of elements the second order convergence
+ * predicts, placed such that they equidistribute |u''|^(1/3) (with u'' from divided
+ * differences of the last solution), and the process repeats. Usually 3-4 steps are needed.
+ *
+ * The mesh is then fine where u'' is large. For the source 100 e^{-10x} this takes about 3 times
+ * fewer points than a uniform mesh for the same error, and reaches errors below 1e-9, which a
+ * uniform mesh cannot since roundoff takes over first.
+ *
+ * @param p Coefficient p(x) > 0
+ * @param f Source term f(x)
+ * @param x0 Left boundary
+ * @param x1 Right boundary
+ * @param tolerance Target max relative error
+ * @param n_initial Number of steps of the initial uniform mesh
+ * @param max_refinements Maximum number of refinement steps
+ * @return The bisected mesh and its solution from the last step, with the error estimate
+ */
+AdaptiveSolution adaptive_algorithm(double (*p)(double), double (*f)(double),
+                                    double x0, double x1, double tolerance,
+                                    int n_initial = 10, int max_refinements = 20);
+
+#endif
@@ -0,0 +1,67 @@
+
+#ifndef __out_of_core_hpp__
+#define __out_of_core_hpp__
+
+#include <string>
+
+/**
+ * Thomas algorithm (as general_algorithm) for (n x n) tridiagonal systems too large to fit in
+ * memory, with the lower diagonal a, main diagonal b and upper diagonal c each streamed from a file.
+ *
+ * The right hand side is streamed from `rhs_filename`, which holds the n values of g as raw
+ * doubles (n is found from the file size), and the diagonals the same way from `a_filename`
+ * (n - 1 doubles), `b_filename` (n doubles) and `c_filename` (n - 1 doubles). The forward sweep
+ * writes (g_tilde_i, 1/b_tilde_i) chunk by chunk to a memory-mapped scratch file, and the backward
+ * sweep maps the same chunks in reverse order and writes the solution directly into the
+ * memory-mapped output file. Only one chunk of each file is mapped at a time, so the resident
+ * memory is O(chunk) rather than O(n); the page cache takes care of the writeback.
+ *
+ * The output has the binary format of OutputWriter (a uint64 with the number of points,
+ * followed by (x_i, v_i) pairs of doubles), with x_i = x_start + i h for i = 0, ..., n - 1.
+ * It holds the unknowns only, not the boundary points.
+ *
+ * Throws std::runtime_error if a file cannot be opened, resized or mapped, or if the diagonals
+ * have the wrong lengths. The scratch file is removed also then.
+ *
+ * @param a_filename Lower diagonal (n - 1 raw doubles)
+ * @param b_filename Main diagonal (n raw doubles)
+ * @param c_filename Upper diagonal (n - 1 raw doubles)
+ * @param rhs_filename Right hand side g (n raw doubles)
+ * @param out_filename Output file (OutputWriter's `.bin` format)
+ * @param scratch_filename Scratch file, 16n bytes; removed when done
+ * @param x_start x-coordinate of the first unknown
+ * @param h Step length
+ * @param chunk Number of elements per mapped chunk (at least 1, else std::runtime_error is thrown)
+ * @return Number of unknowns n
+ */
+long long out_of_core_algorithm(const std::string &a_filename,
+                                const std::string &b_filename,
+                                const std::string &c_filename,
+                                const std::string &rhs_filename,
+                                const std::string &out_filename,
+                                const std::string &scratch_filename,
+                                double x_start, double h, long long chunk = 1 << 20);
+
+/**
+ * As above, but with constant coefficients a, b and c, which are then not read from files.
+ * For the (-1, 2, -1) matrix of the Poisson equation this avoids writing (and reading) three
+ * more files of n doubles, i.e. the disk traffic is that of the right hand side only.
+ *
+ * @param a Lower diagonal entry
+ * @param b Main diagonal entry
+ * @param c Upper diagonal entry
+ * @param rhs_filename Right hand side g (n raw doubles)
+ * @param out_filename Output file (OutputWriter's `.bin` format)
+ * @param scratch_filename Scratch file, 16n bytes; removed when done
+ * @param x_start x-coordinate of the first unknown
+ * @param h Step length
+ * @param chunk Number of elements per mapped chunk (at least 1, else std::runtime_error is thrown)
+ * @return Number of unknowns n
+ */
+long long out_of_core_algorithm(double a, double b, double c,
+                                const std::string &rhs_filename,
+                                const std::string &out_filename,
+                                const std::string &scratch_filename,
+                                double x_start, double h, long long chunk = 1 << 20);
+
+#endif
@@ -0,0 +1,79 @@
+
+#ifndef __output_writer_hpp__
+#define __output_writer_hpp__
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * Buffered writer for (x, y) data points, to be used instead of streaming every point
+ * through std::ofstream.
+ *
+ * Two formats are supported, chosen by the file extension:
+ *  - `.bin`: Raw binary. A uint64 with the number of points, followed by the points as
+ *    (x, y) pairs of doubles, in native byte order.
+ *  - anything else: Text with two comma-separated columns, like `write_to_file` always wrote.
+ *
+ * Points can be decimated, such that only every `stride`-th point is written.
+ * The first and last point given to the writer are always written.
+ */
+class OutputWriter
+{
+private:
+    std::string filename;
+    std::FILE *file;
+    bool binary;
+    bool failed = false;            // Set if any write to the file failed
+    int stride;
+    std::uint64_t n_given = 0;      // Number of points given to write()
+    std::uint64_t n_written = 0;    // Number of points actually written
+
+    std::vector<char> buffer;
+    std::size_t used = 0;
+
+    double last_x, last_y;          // Last point given, in case it is skipped by the stride
+    bool last_written = false;
+
+    void write_point(double x, double y);
+    void flush();
+
+public:
+    /**
+     * Opens `filename` for writing. Throws std::runtime_error if it cannot be opened.
+     * @param filename Name of output file (binary if it ends with `.bin`)
+     * @param stride Only write every stride-th point
+     * @param buffer_size Size of the write buffer in bytes
+     */
+    OutputWriter(std::string filename, int stride = 1, std::size_t buffer_size = 1 << 22);
+
+    /**
+     * Closes the file, see close(). Errors are ignored here, so call close() to get them.
+     */
+    ~OutputWriter();
+
+    OutputWriter(const OutputWriter &) = delete;
+    OutputWriter &operator=(const OutputWriter &) = delete;
+
+    /**
+     * Adds the point (x, y). It is written if its index is a multiple of the stride.
+     */
+    void write(double x, double y);
+
+    /**
+     * Writes the last point (if it was skipped), flushes the buffer and closes the file.
+     * Throws std::runtime_error if any of the writes failed, e.g. because the disk is full.
+     */
+    void close();
+};
+
+/**
+ * Stride needed to write (about) `target` points out of `n_points`.
+ * @param n_points Total number of points
+ * @param target Wanted number of points, or 0 to write all
+ * @return Stride, at least 1
+ */
+int decimation_stride(long long n_points, long long target);
+
+#endif
@@ -0,0 +1,48 @@
+
+#ifndef __parallel_tridiagonal_hpp__
+#define __parallel_tridiagonal_hpp__
+
+#include <vector>
+#include <thread>
+
+/**
+ * Multi-threaded partitioned solver for a general (n x n) tridiagonal system Av = g.
+ *
+ * The rows are split into one contiguous block per thread. Each thread runs a modified
+ * Thomas algorithm on its block, which expresses every row in terms of the first and
+ * last unknown of the block only. These first/last rows form a reduced tridiagonal
+ * system of size 2 * n_threads, which is solved sequentially. Finally, each thread
+ * recovers the interior of its block from the two interface values.
+ *
+ * @param a Lower diagonal entries of A (length n - 1)
+ * @param b Main  diagonal entries of A (length n)
+ * @param c Upper diagonal entries of A (length n - 1)
+ * @param g Right hand side (length n)
+ * @param n_threads Number of threads (defaults to the number of available cores)
+ * @return Solution vector v, without boundaries (length n)
+ */
+std::vector<double> parallel_general_algorithm(const std::vector<double> &a,
+                                               const std::vector<double> &b,
+                                               const std::vector<double> &c,
+                                               const std::vector<double> &g,
+                                               int n_threads = std::thread::hardware_concurrency());
+
+/**
+ * In-place version of the partitioned solver above, which overwrites g with the solution.
+ * @param a Lower diagonal entries of A (length n - 1)
+ * @param b Main  diagonal entries of A (length n)
+ * @param c Upper diagonal entries of A (length n - 1)
+ * @param g Right hand side on input, solution (without boundaries) on output (length n)
+ * @param n Size of the system
+ * @param workspace Workspace for the modified coefficients, reused between calls (length 2n)
+ * @param n_threads Number of threads
+ */
+void parallel_general_algorithm(const double *a,
+                                const double *b,
+                                const double *c,
+                                double *g,
+                                int n,
+                                double *workspace,
+                                int n_threads);
+
+#endif
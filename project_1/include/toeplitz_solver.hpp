@@ -0,0 +1,65 @@
+
+#ifndef __toeplitz_solver_hpp__
+#define __toeplitz_solver_hpp__
+
+#include <vector>
+
+/**
+ * Thomas algorithm for an (n x n) tridiagonal Toeplitz matrix A, i.e. constant
+ * coefficients a (lower diagonal), b (main diagonal) and c (upper diagonal).
+ *
+ * No coefficient arrays are read. The pivots b_tilde_0 = b, b_tilde_i = b - ac/b_tilde_{i-1}
+ * are handled in one of two ways, chosen in the constructor:
+ *  - b^2 = 4ac (e.g. the (-1, 2, -1) matrix of the special algorithm): the pivots are known
+ *    in closed form, b_tilde_i = (b/2)(i + 2)/(i + 1), and nothing is stored.
+ *  - otherwise: the reciprocal pivots are tabulated. If b^2 > 4ac they converge to a limit,
+ *    and the table is cut off once it is reached to machine precision, so that its length
+ *    is O(1) rather than n. Beyond the table the constant limit is used.
+ * Each case has its own compile-time specialized sweep, so the inner loops do not branch.
+ *
+ * T is float, double or long double (instantiated in toeplitz_solver.cpp).
+ */
+template <typename T>
+class ToeplitzSolver
+{
+private:
+    T a, b, c;
+    int n;
+
+    bool closed_form;               // Whether b^2 = 4ac
+    std::vector<T> inv_b_tilde;     // 1/b_tilde_i for i < table_size()
+    T inv_b_limit;                  // 1/b_tilde_i for i >= table_size()
+
+    void solve_closed_form(T *g) const;
+    void solve_tabulated(T *g) const;
+
+public:
+    /**
+     * Sets up the pivots of the (n x n) Toeplitz matrix (a, b, c).
+     * @param a Lower diagonal entry
+     * @param b Main diagonal entry
+     * @param c Upper diagonal entry
+     * @param n Size of the system
+     */
+    ToeplitzSolver(T a, T b, T c, int n);
+
+    /**
+     * @return Number of stored pivots (0 for the closed form case).
+     */
+    int table_size() const;
+
+    /**
+     * Solves Av = g in place.
+     * @param g Right hand side on input, solution (without boundaries) on output (length n)
+     */
+    void solve(T *g) const;
+
+    /**
+     * Solves Av = g.
+     * @param g Right hand side (length n)
+     * @return Solution vector v, without boundaries (length n)
+     */
+    std::vector<T> solve(std::vector<T> g) const;
+};
+
+#endif
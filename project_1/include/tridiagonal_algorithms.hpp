@@ -9,6 +9,11 @@
 #include <iomanip>
 #include <iostream>
 
+/*
+ * All algorithms are templated on the scalar type T, and are instantiated for
+ * T = float, double and long double in tridiagonal_algorithms.cpp.
+ */
+
 /**
  * Applies the Thomas algorithm to find the vector v solving Av = g,
  * for a general (n x n) tridiagonal matrix A.
@@ -18,14 +23,79 @@
  * @param g Right hand side (length n)
  * @return Solution vector, including boundaries (length n + 2)
  */
-std::vector<double> general_algorithm(std::vector<double> a,
-                                      std::vector<double> b,
-                                      std::vector<double> c,
-                                      std::vector<double> g);
+template <typename T>
+std::vector<T> general_algorithm(const std::vector<T> &a,
+                                 const std::vector<T> &b,
+                                 const std::vector<T> &c,
+                                 const std::vector<T> &g);
+
+/**
+ * Applies the special algorithm, i.e. the Thomas algorithm for the (n x n) matrix
+ * with 2 on the main diagonal and -1 on the off-diagonals, using the in-place version below.
+ * @param g Right hand side (length n)
+ * @return Solution vector, including boundaries (length n + 2)
+ */
+template <typename T>
+std::vector<T> special_algorithm(const std::vector<T> &g);
+
+/**
+ * In-place version of the Thomas algorithm for a general (n x n) tridiagonal matrix A.
+ * Overwrites the right hand side g with the solution v of Av = g, and does no heap
+ * allocations, so it can be called repeatedly on caller-owned arrays.
+ * @param a Lower diagonal entries of A (length n - 1)
+ * @param b Main  diagonal entries of A (length n)
+ * @param c Upper diagonal entries of A (length n - 1)
+ * @param g Right hand side on input, solution (without boundaries) on output (length n)
+ * @param n Size of the system
+ * @param b_tilde Workspace for the forward sweep, reused between calls (length n)
+ */
+template <typename T>
+void general_algorithm(const T *a,
+                       const T *b,
+                       const T *c,
+                       T *g,
+                       int n,
+                       T *b_tilde);
+
+/**
+ * In-place version of the special algorithm, i.e. the Thomas algorithm for the
+ * (n x n) matrix with 2 on the main diagonal and -1 on the off-diagonals.
+ * Here b_tilde_i = (i + 2)/(i + 1) is known in closed form, so no workspace is needed.
+ * @param g Right hand side on input, solution (without boundaries) on output (length n)
+ * @param n Size of the system
+ */
+template <typename T>
+void special_algorithm(T *g, int n);
+
+/**
+ * Streaming version of the special algorithm, solving -u''(x) = f(x) on [x0, x1]
+ * with u(x0) = u(x1) = 0. The right hand side g_i = h^2 f(x_i) is evaluated inside the
+ * forward sweep instead of being stored, so v only ever holds g_tilde and then the solution.
+ * @param source Source term f(x), evaluated in double precision
+ * @param x0 Left boundary
+ * @param x1 Right boundary
+ * @param n_steps Number of steps, such that h = (x1 - x0)/n_steps
+ * @param v Solution at x_i = x0 + i h, including boundaries (length n_steps + 1)
+ * @param numerov Use the fourth order right hand side of numerov_rhs instead of h^2 f(x_i)
+ */
+template <typename T>
+void streaming_special_algorithm(double (*source)(double), double x0, double x1, int n_steps, T *v,
+                                 bool numerov = false);
 
 /**
- * TODO: documentation
+ * Right hand side of the fourth order compact (Numerov) discretization of -u''(x) = f(x),
+ *   -v_{i-1} + 2v_i - v_{i+1} = h^2 (f_{i-1} + 10 f_i + f_{i+1})/12,   i = 1, ..., n_steps - 1.
+ * The matrix is the same (-1, 2, -1) matrix as for the second order scheme, so any of the
+ * solvers above can be used; only the right hand side differs. The error is O(h^4) instead
+ * of O(h^2), so the same accuracy takes about the square root of the number of points.
+ * Note that f is also evaluated at the boundaries x0 and x1.
+ * @param source Source term f(x)
+ * @param x0 Left boundary
+ * @param x1 Right boundary
+ * @param n_steps Number of steps, such that h = (x1 - x0)/n_steps
+ * @param g Right hand side of the unknowns at x_1, ..., x_{n_steps - 1} (length n_steps - 1)
  */
-std::vector<double> special_algorithm(std::vector<double> g);
+template <typename T>
+void numerov_rhs(double (*source)(double), double x0, double x1, int n_steps, T *g);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,62 @@
+
+#ifndef __tridiagonal_factorization_hpp__
+#define __tridiagonal_factorization_hpp__
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * Stores the forward-sweep of the Thomas algorithm for a fixed (n x n) tridiagonal
+ * matrix A, such that Av = g can be solved for many right hand sides g without
+ * recomputing b_tilde every time.
+ *
+ * The factorization is computed once in the constructor. Each solve then only does
+ * the g_tilde-sweep and the back substitution.
+ */
+class TridiagonalFactorization
+{
+private:
+    int n;                              // Size of the system
+    std::vector<double> c;              // Upper diagonal entries of A (length n - 1)
+    std::vector<double> multiplier;     // a_i / b_tilde_{i-1}, with multiplier[0] unused (length n)
+    std::vector<double> inv_b_tilde;    // 1 / b_tilde_i (length n)
+
+public:
+    /**
+     * Computes and stores the forward-sweep multipliers of A.
+     * @param a Lower diagonal entries of A (length n - 1)
+     * @param b Main  diagonal entries of A (length n)
+     * @param c Upper diagonal entries of A (length n - 1)
+     */
+    TridiagonalFactorization(const std::vector<double> &a,
+                             const std::vector<double> &b,
+                             const std::vector<double> &c);
+
+    /**
+     * @return Size n of the factorized system.
+     */
+    int size() const;
+
+    /**
+     * Solves Av = g for a single right hand side.
+     * @param g Right hand side (length n)
+     * @return Solution vector v, without boundaries (length n)
+     */
+    std::vector<double> solve(std::vector<double> g) const;
+
+    /**
+     * Solves AV = G for `n_rhs` right hand sides at once, overwriting G with V.
+     * The columns are stored interleaved, i.e. entry i of right hand side j is found at
+     * G[i * n_rhs + j], so that both sweeps run over contiguous memory across the columns.
+     * @param G Interleaved right hand sides (length n * n_rhs)
+     * @param n_rhs Number of right hand sides
+     */
+    void solve_many(std::vector<double> &G, int n_rhs) const;
+
+    /**
+     * Same as above, but for a caller-owned interleaved array G (length n * n_rhs).
+     */
+    void solve_many(double *G, int n_rhs) const;
+};
+
+#endif
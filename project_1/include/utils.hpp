@@ -10,12 +10,14 @@
 #include <iostream>
 
 /**
- * Creates a file `filename` with two comma-separated columns `x` and `y`.
+ * Creates a file `filename` with two comma-separated columns `x` and `y`,
+ * or a binary file if `filename` ends with `.bin` (see @ref OutputWriter).
  * @param x Values in column #1
  * @param y Values in column #2
  * @param filename Name of output file
+ * @param stride Only write every stride-th point (the last point is always written)
  */
-void write_to_file(std::vector<double> x, std::vector<double> y, std::string filename);
+void write_to_file(const std::vector<double> &x, const std::vector<double> &y, std::string filename, int stride = 1);
 
 /**
  * The source-term of the Poisson equation `-u(x)'' = f(x)` we want to solve.
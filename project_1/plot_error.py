@@ -1,4 +1,5 @@
 import numpy as np
+from read_output import load
 import matplotlib.pyplot as plt
 from scipy.interpolate import interp1d
 from tabulate import tabulate
@@ -8,7 +9,7 @@ DATA_PATH = "build/data"
 FIG_PATH = "build/figs"
 
 # Plot exact solution:
-data_exact = np.loadtxt(f"{DATA_PATH}/exact_solution.csv", delimiter=",")
+data_exact = load(f"{DATA_PATH}/exact_solution.csv")
 
 x_exact = data_exact[:,0]
 u_exact = data_exact[:,1]
@@ -22,7 +23,7 @@ fig_rel, ax_rel = plt.subplots(figsize=(8,4))
 
 # Plot numerical solutions from the Thomas algorithm:
 for n_steps in [10, 100, 1000, 10000]:
-    data_num = np.loadtxt(f"{DATA_PATH}/thomas_n-1e{int(np.log10(n_steps))}.csv", delimiter=",")
+    data_num = load(f"{DATA_PATH}/thomas_n-1e{int(np.log10(n_steps))}.csv")
     x_num = data_num[1:-1,0]
     v_num = data_num[1:-1,1]
     u_anal = interp_exact(x_num)    
@@ -55,7 +56,7 @@ n_array = np.array([1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7])
 powers = np.array([1, 2, 3, 4, 5, 6, 7])
 
 for p in powers:
-    data_num = np.loadtxt(f"{DATA_PATH}/thomas_n-1e{p}.csv", delimiter=",")
+    data_num = load(f"{DATA_PATH}/thomas_n-1e{p}.csv")
 
     x_num = data_num[1:-1,0]
     v_num = data_num[1:-1,1]
@@ -1,4 +1,5 @@
 import numpy as np
+from read_output import load
 import matplotlib.pyplot as plt
 import sys
 plt.style.use("ggplot")
@@ -10,7 +11,7 @@ plot_numerical = False
 figname = "exact_solution.pdf"
 
 # Plot exact solution:
-data_exact = np.loadtxt(f"{DATA_PATH}/exact_solution.csv", delimiter=",")
+data_exact = load(f"{DATA_PATH}/exact_solution.csv")
 x_exact = data_exact[:,0]
 u_exact = data_exact[:,1]
 
@@ -25,8 +26,8 @@ if plot_numerical:
     # Plot numerical solutions from the Thomas algorithm:
     powers = np.array([1, 2, 3, 4])
     for p in powers:
-        #data_num = np.loadtxt(f"data/special_n-1e{p}.csv", delimiter=",")
-        data_num = np.loadtxt(f"{DATA_PATH}/thomas_n-1e{p}.csv", delimiter=",")
+        #data_num = load(f"data/special_n-1e{p}.csv")
+        data_num = load(f"{DATA_PATH}/thomas_n-1e{p}.csv")
         
         n_steps = int(10**p)
         x_num = data_num[:,0]
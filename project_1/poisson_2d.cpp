@@ -0,0 +1,88 @@
+#include <vector>
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <stdexcept>
+#include <chrono>
+#include <algorithm>
+
+#include "arg_parser.hpp"
+#include "output_writer.hpp"
+#include "adi.hpp"
+#include "dst_poisson.hpp"
+
+/**
+ * Solves -(u_xx + u_yy) = f on the unit square with u = 0 on the boundary, for
+ * f(x, y) = 2 pi^2 sin(pi x) sin(pi y), whose solution is u(x, y) = sin(pi x) sin(pi y).
+ * Uses the ADI solver, or the DST solver with --dst, and prints the time and maximum error.
+ * The solution along y = 1/2 is written to file.
+ */
+int main(int argc, char *argv[])
+{
+    Args args = parse_args(argc, argv);
+
+    int steps = args.n_steps;           // (no. of steps in both x and y)
+    const double h = 1.0 / steps;
+    int n = steps - 1;                  // ( unknowns in each direction, without the boundaries )
+
+    auto u = [](double x, double y) { return std::sin(M_PI * x) * std::sin(M_PI * y); };
+
+    std::vector<double> g(n * n);
+    for (int j = 0; j < n; j++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            g[j * n + i] = h * h * 2 * M_PI * M_PI * u((i + 1) * h, (j + 1) * h);
+        }
+    }
+    std::vector<double> v(n * n, 0.0);
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    if (args.dst)
+    {
+        DSTPoissonSolver solver(n, n);
+        v = solver.solve(g);
+    }
+    else
+    {
+        ADISolver solver(n, n, args.n_threads);
+        int iterations = solver.poisson(g.data(), v.data());
+        std::cout << "ADI iterations: " << iterations << "\n";
+    }
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "Elapsed time: " << duration_seconds << " s\n";
+
+    double max_error = 0;
+    for (int j = 0; j < n; j++)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            max_error = std::max(max_error, std::abs(v[j * n + i] - u((i + 1) * h, (j + 1) * h)));
+        }
+    }
+    std::cout << "Max error: " << max_error << "\n";
+
+    // Row closest to y = 1/2:
+    int j = std::max(0, steps / 2 - 1);
+    try
+    {
+        OutputWriter writer(args.filename, decimation_stride(steps + 1, args.n_points));
+        writer.write(0, 0);
+        for (int i = 0; i < n; i++)
+        {
+            writer.write((i + 1) * h, v[j * n + i]);
+        }
+        writer.write(1, 0);
+        writer.close();
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        exit(1);
+    }
+
+    return 0;
+}
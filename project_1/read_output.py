@@ -0,0 +1,14 @@
+import numpy as np
+
+
+def load(filename):
+    """
+    Reads (x, y) data written by the C++ programs, as an array of shape (n, 2).
+    Files ending with `.bin` are read as binary (see OutputWriter), anything else as csv.
+    """
+    if filename.endswith(".bin"):
+        with open(filename, "rb") as infile:
+            n = int(np.fromfile(infile, dtype=np.uint64, count=1)[0])
+            return np.fromfile(infile, dtype=np.float64, count=2*n).reshape(n, 2)
+
+    return np.loadtxt(filename, delimiter=",")
@@ -4,49 +4,136 @@
 #include <string>
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
 #include <chrono>
 
 #include "utils.hpp"
+#include "arg_parser.hpp"
+#include "output_writer.hpp"
 #include "tridiagonal_algorithms.hpp"
 
-int main(int argc, char *argv[])
+/**
+ * Solves the Poisson equation with the special algorithm in precision T, and writes the solution.
+ */
+template <typename T>
+void solve(const Args &args)
 {
-    if (argc != 3)
+    int steps = args.n_steps; // (no. of steps in the FULL solution)
+    std::string filename = args.filename;
+    const T x0 = 0.0;
+    const T x1 = 1.0;
+    const T h = (x1 - x0) / steps;
+
+    if (args.stream)
     {
-        std::string executable_name = argv[0];
-        std::cerr << "Error: Wrong number of input arguments.\n";
-        std::cerr << "Usage: " << executable_name << " <step number> <filename>\n";
-        return 1;
+        // Streaming solver: no x- or g-vectors, only v:
+        std::vector<T> v(steps + 1);
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        streaming_special_algorithm(source_term, x0, x1, steps, v.data(), args.numerov);
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+        std::cout << "Elapsed time: " << duration_seconds << " s\n";
+
+        OutputWriter writer(filename, decimation_stride(steps + 1, args.n_points));
+        for (int i = 0; i <= steps; i++)
+        {
+            writer.write(x0 + i * h, v[i]);
+        }
+        writer.close();
+
+        return;
     }
 
-    int steps = std::stod(argv[1]); // (no. of steps in the FULL solution)
-    std::string filename = argv[2];
-    const double x0 = 0.0;
-    const double x1 = 1.0;
-    const double h = (x1 - x0) / steps;
+    if (args.numerov)
+    {
+        // Fourth order right hand side, solved in place for the n = steps - 1 unknowns:
+        int n = steps - 1;
+        std::vector<T> v(n);
+        numerov_rhs(source_term, x0, x1, steps, v.data());
 
-    // Initialize and fill x-, v-, and g-vectors:
-    std::vector<double> x(steps + 1);
-    std::vector<double> g(steps + 1);
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        special_algorithm(v.data(), n);
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+        std::cout << "Elapsed time: " << duration_seconds << " s\n";
+
+        OutputWriter writer(filename, decimation_stride(steps + 1, args.n_points));
+        writer.write(x0, 0);
+        for (int i = 0; i < n; i++)
+        {
+            writer.write(x0 + (i + 1) * h, v[i]);
+        }
+        writer.write(x1, 0);
+        writer.close();
+
+        return;
+    }
+
+    // Initialize and fill x- and g-vectors, with g only at the unknowns x_1, ..., x_{steps - 1}:
+    std::vector<T> x(steps + 1);
+    std::vector<T> g(steps - 1);
     x[0] = x0;
-    g[0] = h * h * source_term(0);
 
     for (int i = 1; i <= steps; i++)
     {
         x[i] = x[i - 1] + h;
-        g[i] = h * h * source_term(x[i]);
     }
-
-    int n = x.size() - 2; // ( matrix eq. does not include the boundaries )
+    for (int i = 0; i < steps - 1; i++)
+    {
+        g[i] = h * h * T(source_term(x[i + 1]));
+    }
 
     auto t1 = std::chrono::high_resolution_clock::now();
     
-    std::vector<double> v = special_algorithm(g);
+    std::vector<T> v = special_algorithm(g);
 
     auto t2 = std::chrono::high_resolution_clock::now();
     double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
     std::cout << "Elapsed time: " << duration_seconds << " s\n";
 
-    // Comment out when timing algorithms:
-    // write_to_file(x, v, filename);
+    // (Use the benchmark program for proper timings)
+    OutputWriter writer(filename, decimation_stride(x.size(), args.n_points));
+    for (int i = 0; i < x.size(); i++)
+    {
+        writer.write(x[i], v[i]);
+    }
+    writer.close();
+}
+
+int main(int argc, char *argv[])
+{
+    Args args = parse_args(argc, argv);
+
+    if (args.dst || args.tolerance > 0 || args.out_of_core)
+    {
+        std::cerr << "Error: --dst, --adaptive and --out-of-core are only available in thomas_algorithm.\n";
+        exit(1);
+    }
+
+    // Report errors (e.g. an output file that cannot be written) instead of terminating:
+    try
+    {
+        if (args.precision == "float")
+        {
+            solve<float>(args);
+        }
+        else if (args.precision == "long_double")
+        {
+            solve<long double>(args);
+        }
+        else
+        {
+            solve<double>(args);
+        }
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        exit(1);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+
+#include "adi.hpp"
+#include "tridiagonal_factorization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+
+namespace
+{
+    const int W = ADISolver::lanes;
+
+    /**
+     * Lets n_threads threads wait for each other, as in parallel_jacobi.
+     */
+    class Barrier
+    {
+    private:
+        std::mutex mutex;
+        std::condition_variable all_arrived;
+        int n_threads;
+        int waiting = 0;
+        long generation = 0;
+
+    public:
+        Barrier(int n_threads) : n_threads(n_threads) {}
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            long arrived_in = generation;
+            if (++waiting == n_threads)
+            {
+                waiting = 0;
+                generation++;
+                all_arrived.notify_all();
+            }
+            else
+            {
+                all_arrived.wait(lock, [&] { return generation != arrived_in; });
+            }
+        }
+    };
+
+    /**
+     * Tile t of one layout, whose lines have length n and which has m lines in total, from
+     * the other layout (lines of length m, n lines). The tile consists of one (W x W) block
+     * from each tile of the other layout, transposed. Lanes beyond the m'th line are zeroed.
+     * @param other Other layout
+     * @param t Tile to gather
+     * @param tile Result (length n * W)
+     */
+    void gather_tile(const double *other, int t, int n, int m, double *tile)
+    {
+        const int lines = std::min(W, m - t * W);
+
+        for (int s = 0; s * W < n; s++)
+        {
+            const int positions = std::min(W, n - s * W);
+            const double *block = other + (std::size_t(s) * m + t * W) * W;
+            double *target = tile + std::size_t(s) * W * W;
+
+            for (int p = 0; p < positions; p++)
+            {
+                for (int q = 0; q < lines; q++)
+                {
+                    target[p * W + q] = block[q * W + p];
+                }
+                for (int q = lines; q < W; q++)
+                {
+                    target[p * W + q] = 0;
+                }
+            }
+        }
+    }
+
+    /**
+     * out = g + (rho - A_1) v on a tile with lines of length n, where A_1 is the
+     * (-1, 2, -1) matrix along the lines (the explicit half of the next half step).
+     */
+    void explicit_part(const double *g, const double *v, double rho, int n, double *out)
+    {
+        for (int p = 0; p < n; p++)
+        {
+            const double *previous = (p > 0) ? v + (p - 1) * W : nullptr;
+            const double *next = (p < n - 1) ? v + (p + 1) * W : nullptr;
+
+            for (int q = 0; q < W; q++)
+            {
+                double value = g[p * W + q] + (rho - 2) * v[p * W + q];
+                value += previous ? previous[q] : 0.0;
+                value += next ? next[q] : 0.0;
+                out[p * W + q] = value;
+            }
+        }
+    }
+
+    /**
+     * The (n x n) matrix rho + (-1, 2, -1).
+     */
+    TridiagonalFactorization shifted_factorization(int n, double rho)
+    {
+        return TridiagonalFactorization(std::vector<double>(n - 1, -1.0),
+                                        std::vector<double>(n, 2.0 + rho),
+                                        std::vector<double>(n - 1, -1.0));
+    }
+}
+
+ADISolver::ADISolver(int nx, int ny, int n_threads) : nx(nx), ny(ny), n_threads(n_threads)
+{
+    tiles_x = (ny + W - 1) / W;
+    tiles_y = (nx + W - 1) / W;
+
+    g_x.resize(std::size_t(tiles_x) * nx * W);
+    rhs_x.resize(g_x.size());
+    g_y.resize(std::size_t(tiles_y) * ny * W);
+    rhs_y.resize(g_y.size());
+    v_y.resize(g_y.size());
+}
+
+void ADISolver::to_layouts(const double *g, const double *v)
+{
+    std::fill(g_x.begin(), g_x.end(), 0.0);
+    std::fill(g_y.begin(), g_y.end(), 0.0);
+    std::fill(v_y.begin(), v_y.end(), 0.0);
+
+    for (int j = 0; j < ny; j++)
+    {
+        for (int i = 0; i < nx; i++)
+        {
+            const std::size_t x_index = (std::size_t(j / W) * nx + i) * W + j % W;
+            const std::size_t y_index = (std::size_t(i / W) * ny + j) * W + i % W;
+
+            g_x[x_index] = g ? g[j * nx + i] : 0.0;
+            g_y[y_index] = g ? g[j * nx + i] : 0.0;
+            v_y[y_index] = v[j * nx + i];
+        }
+    }
+}
+
+void ADISolver::from_layout(double *v) const
+{
+    for (int j = 0; j < ny; j++)
+    {
+        for (int i = 0; i < nx; i++)
+        {
+            v[j * nx + i] = v_y[(std::size_t(i / W) * ny + j) * W + i % W];
+        }
+    }
+}
+
+int ADISolver::iterate(const std::vector<double> &shifts, int max_iterations, double tolerance)
+{
+    const int n_shifts = shifts.size();
+
+    std::vector<TridiagonalFactorization> factorizations_x, factorizations_y;
+    for (double rho : shifts)
+    {
+        factorizations_x.push_back(shifted_factorization(nx, rho));
+        factorizations_y.push_back(shifted_factorization(ny, rho));
+    }
+
+    // Convergence is checked on the change over a full cycle of shifts, as the large shifts
+    // hardly change the smooth components (so single iterations can look converged early):
+    std::vector<double> cycle_start(tolerance > 0 ? v_y.size() : 0);
+    std::vector<double> change(tiles_y);
+    std::vector<double> size(tiles_y);
+
+    // The threads live through all iterations, each with a contiguous range of tiles in both layouts,
+    // and wait for each other between the sweeps (which read the other layout written by all threads):
+    const int n_blocks = std::max(1, std::min(n_threads, std::max(tiles_x, tiles_y)));
+    Barrier barrier(n_blocks);
+    int iterations = 0;
+
+    auto worker = [&](int p)
+    {
+        const int x_begin = tiles_x * p / n_blocks;
+        const int x_end = tiles_x * (p + 1) / n_blocks;
+        const int y_begin = tiles_y * p / n_blocks;
+        const int y_end = tiles_y * (p + 1) / n_blocks;
+
+        std::vector<double> tile(std::size_t(nx) * W);
+
+        // Right hand sides of the first x-sweep:
+        for (int t = y_begin; t < y_end; t++)
+        {
+            const std::size_t offset = std::size_t(t) * ny * W;
+            explicit_part(g_y.data() + offset, v_y.data() + offset, shifts[0], ny, rhs_y.data() + offset);
+        }
+        barrier.wait();
+
+        int iteration = 0;
+        while (iteration < max_iterations)
+        {
+            const int k = iteration % n_shifts;
+            const int k_next = (iteration + 1) % n_shifts;
+            const bool check = tolerance > 0 && k == n_shifts - 1;
+
+            if (tolerance > 0 && k == 0)
+            {
+                // (only the own tiles, which are also the only ones compared below)
+                std::copy(v_y.begin() + std::size_t(y_begin) * ny * W, v_y.begin() + std::size_t(y_end) * ny * W,
+                          cycle_start.begin() + std::size_t(y_begin) * ny * W);
+            }
+
+            // Implicit in x: solve the lines of each x-tile, then the explicit part of the y-sweep:
+            for (int t = x_begin; t < x_end; t++)
+            {
+                const std::size_t offset = std::size_t(t) * nx * W;
+
+                gather_tile(rhs_y.data(), t, nx, ny, tile.data());
+                factorizations_x[k].solve_many(tile.data(), W);
+                explicit_part(g_x.data() + offset, tile.data(), shifts[k], nx, rhs_x.data() + offset);
+            }
+            barrier.wait();
+
+            // Implicit in y, directly into the solution, then the explicit part of the next x-sweep:
+            for (int t = y_begin; t < y_end; t++)
+            {
+                const std::size_t offset = std::size_t(t) * ny * W;
+                double *v_tile = v_y.data() + offset;
+
+                gather_tile(rhs_x.data(), t, ny, nx, v_tile);
+                factorizations_y[k].solve_many(v_tile, W);
+                explicit_part(g_y.data() + offset, v_tile, shifts[k_next], ny, rhs_y.data() + offset);
+
+                if (check)
+                {
+                    change[t] = 0;
+                    size[t] = 0;
+                    for (std::size_t i = 0; i < std::size_t(ny) * W; i++)
+                    {
+                        change[t] = std::max(change[t], std::abs(v_tile[i] - cycle_start[offset + i]));
+                        size[t] = std::max(size[t], std::abs(v_tile[i]));
+                    }
+                }
+            }
+            barrier.wait();
+
+            iteration++;
+
+            // Every thread makes the same decision. (change is not written again before the next barrier.)
+            if (check && *std::max_element(change.begin(), change.end())
+                             <= tolerance * *std::max_element(size.begin(), size.end()))
+            {
+                break;
+            }
+        }
+
+        if (p == 0)
+        {
+            iterations = iteration;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int p = 1; p < n_blocks; p++)
+    {
+        threads.emplace_back(worker, p);
+    }
+    worker(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    return iterations;
+}
+
+int ADISolver::poisson(const double *g, double *v, double tolerance, int max_iterations)
+{
+    // Eigenvalues of the (-1, 2, -1) matrices are 4 sin^2(pi k/(2(n + 1))), k = 1, ..., n:
+    auto eigenvalue = [](int k, int n) {
+        double s = std::sin(M_PI * k / (2.0 * (n + 1)));
+        return 4 * s * s;
+    };
+    const double mu_min = std::min(eigenvalue(1, nx), eigenvalue(1, ny));
+    const double mu_max = std::max(eigenvalue(nx, nx), eigenvalue(ny, ny));
+
+    const int n_shifts = std::max(1, static_cast<int>(std::ceil(std::log(mu_max / mu_min))));
+    std::vector<double> shifts(n_shifts);
+    for (int k = 0; k < n_shifts; k++)
+    {
+        shifts[k] = mu_min * std::pow(mu_max / mu_min, (k + 0.5) / n_shifts);
+    }
+
+    to_layouts(g, v);
+    int iterations = iterate(shifts, max_iterations, tolerance);
+    from_layout(v);
+
+    return iterations;
+}
+
+void ADISolver::diffusion(double *v, double r, int n_steps)
+{
+    to_layouts(nullptr, v);
+    iterate({2 / r}, n_steps, 0);
+    from_layout(v);
+}
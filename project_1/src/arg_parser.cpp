@@ -0,0 +1,122 @@
+
+#include "arg_parser.hpp"
+
+#include <cstdlib>
+
+void print_usage(std::string executable_name)
+{
+    std::cout << "Usage:\n"
+              << "  " << executable_name << " <step number> <filename> [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  --points <int>    Decimate the output to about this many points (default: all)\n"
+              << "  --stream          Use the streaming solver (special_algorithm only)\n"
+              << "  --numerov         Fourth order (Numerov) discretization (thomas_algorithm and special_algorithm)\n"
+              << "  --dst             Use the sine transform (DST) Poisson solver (thomas_algorithm and poisson_2d)\n"
+              << "  --adaptive <tol>  Refine a nonuniform mesh until the max relative error is below tol,\n"
+              << "                    starting from <step number> steps (thomas_algorithm only)\n"
+              << "  --out-of-core     Solve out of core with memory-mapped files (thomas_algorithm only, .bin output)\n"
+              << "  --dt <float>      Time step (diffusion only, default: h)\n"
+              << "  --time-steps <int> Number of time steps (diffusion only, default: 100)\n"
+              << "  --theta <float>   0.5 for Crank-Nicolson, 1 for backward Euler (diffusion only, default: 0.5)\n"
+              << "  --snapshot-every <int> Write a snapshot every this many time steps (diffusion only, default: final only)\n"
+              << "  --threads <int>   Number of threads (error_study and poisson_2d, default: all cores)\n"
+              << "  --precision <str> float, double or long_double (solvers only, default: double)\n"
+              << "  --help            Show this help message\n";
+}
+
+Args parse_args(int argc, char *argv[])
+{
+    Args args;
+    std::string executable_name = argv[0];
+    int n_positional = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--points" && i + 1 < argc)
+        {
+            args.n_points = std::stoll(argv[++i]);
+        }
+        else if (arg == "--stream")
+        {
+            args.stream = true;
+        }
+        else if (arg == "--numerov")
+        {
+            args.numerov = true;
+        }
+        else if (arg == "--dst")
+        {
+            args.dst = true;
+        }
+        else if (arg == "--adaptive" && i + 1 < argc)
+        {
+            args.tolerance = std::stod(argv[++i]);
+        }
+        else if (arg == "--out-of-core")
+        {
+            args.out_of_core = true;
+        }
+        else if (arg == "--dt" && i + 1 < argc)
+        {
+            args.dt = std::stod(argv[++i]);
+        }
+        else if (arg == "--time-steps" && i + 1 < argc)
+        {
+            args.time_steps = std::stod(argv[++i]);
+        }
+        else if (arg == "--theta" && i + 1 < argc)
+        {
+            args.theta = std::stod(argv[++i]);
+        }
+        else if (arg == "--snapshot-every" && i + 1 < argc)
+        {
+            args.snapshot_every = std::stoi(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            args.n_threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--precision" && i + 1 < argc)
+        {
+            args.precision = argv[++i];
+            if (args.precision != "float" && args.precision != "double" && args.precision != "long_double")
+            {
+                std::cerr << "Unknown precision: " << args.precision << "\n";
+                exit(1);
+            }
+        }
+        else if (arg == "--help")
+        {
+            print_usage(executable_name);
+            exit(0);
+        }
+        else if (arg.rfind("--", 0) != 0 && n_positional == 0)
+        {
+            args.n_steps = std::stod(arg);      // (allows e.g. 1e7)
+            n_positional++;
+        }
+        else if (arg.rfind("--", 0) != 0 && n_positional == 1)
+        {
+            args.filename = arg;
+            n_positional++;
+        }
+        else
+        {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            print_usage(executable_name);
+            exit(1);
+        }
+    }
+
+    if (n_positional != 2)
+    {
+        std::cerr << "Error: Wrong number of input arguments.\n";
+        print_usage(executable_name);
+        exit(1);
+    }
+
+    return args;
+}
@@ -0,0 +1,135 @@
+
+#include "convergence.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <numeric>
+
+void exp_grid(double k, double x_start, double h, int count, double *out)
+{
+    const int block = 64;
+
+    double table[block];
+    for (int i = 0; i < std::min(block, count); i++)
+    {
+        table[i] = std::exp(k * i * h);
+    }
+
+    for (int b = 0; b < count; b += block)
+    {
+        const double start = std::exp(k * (x_start + b * h));
+        const int length = std::min(block, count - b);
+
+        for (int i = 0; i < length; i++)
+        {
+            out[b + i] = start * table[i];
+        }
+    }
+}
+
+ErrorNorms special_algorithm_errors(int n_steps, double *v)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    // Same problem as in utils.cpp: f(x) = 100 exp(-10x), u(x) = 1 - (1 - exp(-10))x - exp(-10x)
+    const int n = n_steps - 1;
+    const double h = 1.0 / n_steps;
+    const double h2 = h * h;
+    const double slope = 1 - std::exp(-10);
+
+    const int chunk = 4096;
+    double exps[chunk];
+
+    v[0] = 0;
+    v[n_steps] = 0;
+
+    // Forward sweep, as in streaming_special_algorithm (unknown j is stored in v[j + 1]):
+    for (int start = 0; start < n; start += chunk)
+    {
+        const int length = std::min(chunk, n - start);
+        exp_grid(-10, (start + 1) * h, h, length, exps);
+
+        for (int k = 0; k < length; k++)
+        {
+            const int j = start + k;
+            const double g_j = h2 * 100 * exps[k];
+            v[j + 1] = g_j + v[j] * j / (j + 1);     // (v[0] = 0 takes care of j = 0)
+        }
+    }
+
+    // Backward sweep, chunk by chunk from the right, with the errors as running maxima:
+    double max_abs_error = 0;
+    double max_rel_error = 0;
+
+    v[n] = v[n] * n / (n + 1);
+
+    for (int end = n; end > 0; end -= chunk)
+    {
+        const int start = std::max(0, end - chunk);
+        const int length = end - start;
+        exp_grid(-10, (start + 1) * h, h, length, exps);
+
+        for (int j = end - 1; j >= start; j--)
+        {
+            if (j < n - 1)
+            {
+                v[j + 1] = (v[j + 1] + v[j + 2]) * (j + 1) / (j + 2);
+            }
+
+            const double x = (j + 1) * h;
+            const double u = 1 - slope * x - exps[j - start];
+            const double abs_error = std::abs(v[j + 1] - u);
+
+            max_abs_error = std::max(max_abs_error, abs_error);
+            max_rel_error = std::max(max_rel_error, abs_error / std::abs(u));
+        }
+    }
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    ErrorNorms errors;
+    errors.n_steps = n_steps;
+    errors.max_abs_error = max_abs_error;
+    errors.max_rel_error = max_rel_error;
+    errors.seconds = std::chrono::duration<double>(t2 - t1).count();
+
+    return errors;
+}
+
+std::vector<ErrorNorms> error_study(const std::vector<int> &n_steps, int n_threads)
+{
+    int n_tasks = n_steps.size();
+    std::vector<ErrorNorms> results(n_tasks);
+
+    // Largest problems first, for a better load balance:
+    std::vector<int> order(n_tasks);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int i, int j) { return n_steps[i] > n_steps[j]; });
+
+    std::atomic<int> next(0);
+
+    auto worker = [&]() {
+        for (int task = next++; task < n_tasks; task = next++)
+        {
+            int i = order[task];
+            std::vector<double> v(n_steps[i] + 1);
+            results[i] = special_algorithm_errors(n_steps[i], v.data());
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < std::min(n_threads, n_tasks); t++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    return results;
+}
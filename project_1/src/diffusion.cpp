@@ -0,0 +1,23 @@
+
+#include "diffusion.hpp"
+
+ThetaScheme::ThetaScheme(int n, double r, double theta)
+    : n(n), alpha((1 - theta) * r), beta(1 - 2 * (1 - theta) * r),
+      implicit(-theta * r, 1 + 2 * theta * r, -theta * r, n)
+{
+}
+
+void ThetaScheme::step(double *u) const
+{
+    // u = (alpha, beta, alpha) u in place, keeping the old u_{i-1} since it is overwritten first:
+    double u_previous = 0;
+    for (int i = 0; i < n - 1; i++)
+    {
+        const double u_i = u[i];
+        u[i] = beta * u_i + alpha * (u_previous + u[i + 1]);
+        u_previous = u_i;
+    }
+    u[n - 1] = beta * u[n - 1] + alpha * u_previous;
+
+    implicit.solve(u);
+}
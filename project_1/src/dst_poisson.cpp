@@ -0,0 +1,164 @@
+
+#include "dst_poisson.hpp"
+
+#include <cmath>
+#include <complex>
+#include <algorithm>
+
+namespace
+{
+    /**
+     * out = in^T for a (rows x cols) row-major matrix, in blocks that fit in the L1 cache.
+     */
+    void transpose(const double *in, int rows, int cols, double *out)
+    {
+        const int block = 32;
+
+        for (int r0 = 0; r0 < rows; r0 += block)
+        {
+            for (int c0 = 0; c0 < cols; c0 += block)
+            {
+                const int r1 = std::min(r0 + block, rows);
+                const int c1 = std::min(c0 + block, cols);
+
+                for (int r = r0; r < r1; r++)
+                {
+                    for (int c = c0; c < c1; c++)
+                    {
+                        out[c * rows + r] = in[r * cols + c];
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Transforms the `count` contiguous rows of length n in `data`.
+     */
+    void transform_rows(const SineTransform &dst, double *data, int n, int count)
+    {
+        for (int j = 0; j < count; j++)
+        {
+            dst.transform(data + static_cast<long long>(j) * n);
+        }
+    }
+
+    /**
+     * Eigenvalues of the (n x n) matrix (-1, 2, -1).
+     */
+    std::vector<double> eigenvalues(int n)
+    {
+        std::vector<double> mu(n);
+        for (int k = 1; k <= n; k++)
+        {
+            double s = std::sin(M_PI * k / (2.0 * (n + 1)));
+            mu[k - 1] = 4 * s * s;
+        }
+        return mu;
+    }
+}
+
+SineTransform::SineTransform(int n) : n(n), fft(n + 1), twiddles(n + 1)
+{
+    for (int k = 0; k <= n; k++)
+    {
+        twiddles[k] = std::polar(1.0, -M_PI * k / (n + 1));
+    }
+}
+
+void SineTransform::transform(double *x) const
+{
+    const int m = n + 1;
+
+    thread_local std::vector<std::complex<double>> z;
+    z.resize(m);
+
+    // Odd extension r of period 2m, with r_0 = r_m = 0, r_t = x_t and r_{2m - t} = -x_t,
+    // packed as z_j = r_{2j} + i r_{2j + 1}:
+    auto r = [&](int t) {
+        return (t == 0 || t == m) ? 0.0 : (t < m) ? x[t - 1] : -x[2 * m - t - 1];
+    };
+    for (int j = 0; j < m; j++)
+    {
+        z[j] = std::complex<double>(r(2 * j), r(2 * j + 1));
+    }
+
+    fft.transform(z.data());
+
+    // Split into the transforms of the even and odd entries, and combine them to R_k = -2i X_k:
+    for (int k = 1; k <= n; k++)
+    {
+        const std::complex<double> z_k = z[k];
+        const std::complex<double> z_conj = std::conj(z[m - k]);
+
+        const std::complex<double> even = 0.5 * (z_k + z_conj);
+        const std::complex<double> odd = std::complex<double>(0, -0.5) * (z_k - z_conj);
+
+        x[k - 1] = -0.5 * (even + twiddles[k] * odd).imag();
+    }
+}
+
+DSTPoissonSolver::DSTPoissonSolver(int nx, int ny) : nx(nx), ny(ny), dst_x(nx), dst_y(ny)
+{
+    std::vector<double> mu_x = eigenvalues(nx);
+    std::vector<double> mu_y = eigenvalues(ny);
+
+    inv_eigenvalues.resize(static_cast<long long>(nx) * ny);
+
+    if (ny == 1)
+    {
+        const double scale = 2.0 / (nx + 1);
+        for (int i = 0; i < nx; i++)
+        {
+            inv_eigenvalues[i] = scale / mu_x[i];
+        }
+        return;
+    }
+
+    const double scale = 4.0 / ((nx + 1.0) * (ny + 1.0));
+    for (int i = 0; i < nx; i++)
+    {
+        for (int j = 0; j < ny; j++)
+        {
+            inv_eigenvalues[i * ny + j] = scale / (mu_x[i] + mu_y[j]);
+        }
+    }
+}
+
+void DSTPoissonSolver::solve(double *g) const
+{
+    if (ny == 1)
+    {
+        dst_x.transform(g);
+        for (int i = 0; i < nx; i++)
+        {
+            g[i] *= inv_eigenvalues[i];
+        }
+        dst_x.transform(g);
+        return;
+    }
+
+    // Reused between calls, like the buffer in SineTransform::transform:
+    thread_local std::vector<double> transposed;
+    transposed.resize(inv_eigenvalues.size());
+
+    // Along x, then along y on the transposed grid, where the eigenvalues are stored in the same order:
+    transform_rows(dst_x, g, nx, ny);
+    transpose(g, ny, nx, transposed.data());
+    transform_rows(dst_y, transposed.data(), ny, nx);
+
+    for (std::size_t i = 0; i < inv_eigenvalues.size(); i++)
+    {
+        transposed[i] *= inv_eigenvalues[i];
+    }
+
+    transform_rows(dst_y, transposed.data(), ny, nx);
+    transpose(transposed.data(), nx, ny, g);
+    transform_rows(dst_x, g, nx, ny);
+}
+
+std::vector<double> DSTPoissonSolver::solve(std::vector<double> g) const
+{
+    solve(g.data());
+    return g;
+}
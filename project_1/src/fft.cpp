@@ -0,0 +1,168 @@
+
+#include "fft.hpp"
+
+#include <cmath>
+#include <utility>
+#include <algorithm>
+
+namespace
+{
+    /**
+     * a * b, without the inf/nan handling of std::complex (which keeps the loops from vectorizing).
+     */
+    inline std::complex<double> multiply(std::complex<double> a, std::complex<double> b)
+    {
+        return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+    }
+}
+
+FFT::FFT(int n) : n(n)
+{
+    power_of_two = (n & (n - 1)) == 0;
+
+    if (power_of_two)
+    {
+        int bits = 0;
+        while ((1 << bits) < n)
+        {
+            bits++;
+        }
+
+        bit_reversed.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            int reversed = 0;
+            for (int b = 0; b < bits; b++)
+            {
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            bit_reversed[i] = reversed;
+        }
+
+        // The twiddles of each butterfly length are stored contiguously:
+        twiddles.resize(n);
+        for (int half = 1; half < n; half *= 2)
+        {
+            for (int k = 0; k < half; k++)
+            {
+                twiddles[half + k] = std::polar(1.0, -M_PI * k / half);
+            }
+        }
+        return;
+    }
+
+    int m = 1;
+    while (m < 2 * n - 1)
+    {
+        m *= 2;
+    }
+    inner = std::make_unique<FFT>(m);
+
+    // k^2 is reduced modulo 2n first, so that the angle stays accurate for large k:
+    chirp.resize(n);
+    for (int k = 0; k < n; k++)
+    {
+        long long k2 = static_cast<long long>(k) * k % (2LL * n);
+        chirp[k] = std::polar(1.0, -M_PI * k2 / n);
+    }
+
+    chirp_filter.assign(m, 0.0);
+    chirp_filter[0] = std::conj(chirp[0]);
+    for (int k = 1; k < n; k++)
+    {
+        chirp_filter[k] = std::conj(chirp[k]);
+        chirp_filter[m - k] = std::conj(chirp[k]);
+    }
+    inner->transform(chirp_filter.data());
+}
+
+int FFT::size() const
+{
+    return n;
+}
+
+void FFT::transform(std::complex<double> *x) const
+{
+    if (power_of_two)
+    {
+        radix2(x);
+    }
+    else
+    {
+        bluestein(x);
+    }
+}
+
+void FFT::butterflies(std::complex<double> *x, int count, int length) const
+{
+    const int half = length / 2;
+    const std::complex<double> *w = twiddles.data() + half;
+
+    for (int start = 0; start < count; start += length)
+    {
+        std::complex<double> *lower = x + start;
+        std::complex<double> *upper = x + start + half;
+
+        for (int k = 0; k < half; k++)
+        {
+            const std::complex<double> t = multiply(w[k], upper[k]);
+            upper[k] = lower[k] - t;
+            lower[k] += t;
+        }
+    }
+}
+
+void FFT::radix2(std::complex<double> *x) const
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (i < bit_reversed[i])
+        {
+            std::swap(x[i], x[bit_reversed[i]]);
+        }
+    }
+
+    // The short butterflies are done block by block, so that each block stays in cache
+    // through all of its stages. Only the longer ones need a pass over all of x per stage:
+    const int block = std::min(n, 1 << 12);
+
+    for (int start = 0; start < n; start += block)
+    {
+        for (int length = 2; length <= block; length *= 2)
+        {
+            butterflies(x + start, block, length);
+        }
+    }
+
+    for (int length = 2 * block; length <= n; length *= 2)
+    {
+        butterflies(x, n, length);
+    }
+}
+
+void FFT::bluestein(std::complex<double> *x) const
+{
+    const int m = inner->size();
+
+    // (Reused between calls, and one per thread so that transforms can run concurrently)
+    thread_local std::vector<std::complex<double>> work;
+    work.assign(m, 0.0);
+
+    for (int k = 0; k < n; k++)
+    {
+        work[k] = multiply(x[k], chirp[k]);
+    }
+
+    // Convolution with the conjugate chirp. The inverse transform is done as conj(FFT(conj(.))):
+    inner->transform(work.data());
+    for (int k = 0; k < m; k++)
+    {
+        work[k] = std::conj(multiply(work[k], chirp_filter[k]));
+    }
+    inner->transform(work.data());
+
+    for (int k = 0; k < n; k++)
+    {
+        x[k] = multiply(chirp[k], std::conj(work[k])) / static_cast<double>(m);
+    }
+}
@@ -0,0 +1,186 @@
+
+#include "nonuniform_mesh.hpp"
+#include "tridiagonal_algorithms.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * The mesh with every element split in two.
+     */
+    std::vector<double> bisect(const std::vector<double> &x)
+    {
+        std::vector<double> refined;
+        refined.reserve(2 * x.size());
+
+        for (int i = 0; i + 1 < x.size(); i++)
+        {
+            refined.push_back(x[i]);
+            refined.push_back(0.5 * (x[i] + x[i + 1]));
+        }
+        refined.push_back(x.back());
+
+        return refined;
+    }
+
+    /**
+     * |u''| at the mesh points, by divided differences (the boundary points take the value of their neighbour).
+     */
+    std::vector<double> second_derivative(const std::vector<double> &x, const std::vector<double> &u)
+    {
+        const int N = x.size() - 1;
+
+        std::vector<double> u_xx(N + 1, 0.0);
+        for (int i = 1; i < N; i++)
+        {
+            const double h_left = x[i] - x[i - 1];
+            const double h_right = x[i + 1] - x[i];
+            u_xx[i] = std::abs(2 * ((u[i + 1] - u[i]) / h_right - (u[i] - u[i - 1]) / h_left) / (h_left + h_right));
+        }
+        if (N > 1)
+        {
+            u_xx[0] = u_xx[1];
+            u_xx[N] = u_xx[N - 1];
+        }
+        return u_xx;
+    }
+
+    /**
+     * New mesh with N elements, such that the integral of the (piecewise linear) monitor
+     * function M is the same over every element. A monitor which is zero everywhere (e.g.
+     * for f = 0) gives the uniform mesh.
+     */
+    std::vector<double> equidistribute(const std::vector<double> &x, const std::vector<double> &M, int N)
+    {
+        std::vector<double> integral(x.size(), 0.0);
+        for (int i = 0; i + 1 < x.size(); i++)
+        {
+            integral[i + 1] = integral[i] + 0.5 * (M[i] + M[i + 1]) * (x[i + 1] - x[i]);
+        }
+
+        std::vector<double> mesh(N + 1);
+        mesh[0] = x.front();
+        mesh[N] = x.back();
+
+        if (!(integral.back() > 0))
+        {
+            for (int k = 1; k < N; k++)
+            {
+                mesh[k] = x.front() + (x.back() - x.front()) * k / N;
+            }
+            return mesh;
+        }
+
+        int i = 0;
+        for (int k = 1; k < N; k++)
+        {
+            const double level = integral.back() * k / N;
+            while (integral[i + 1] < level && i + 2 < x.size())
+            {
+                i++;
+            }
+            // (Linear within the element, i.e. treating M as constant there)
+            const double width = integral[i + 1] - integral[i];
+            const double t = (width > 0) ? (level - integral[i]) / width : 0.0;
+            mesh[k] = x[i] + t * (x[i + 1] - x[i]);
+        }
+        return mesh;
+    }
+}
+
+std::vector<double> nonuniform_algorithm(const std::vector<double> &x,
+                                         double (*p)(double),
+                                         double (*f)(double))
+{
+    const int N = x.size() - 1;
+    const int n = N - 1;                // ( matrix eq. does not include the boundaries )
+
+    std::vector<double> a(std::max(n - 1, 0)), b(n), c(std::max(n - 1, 0)), g(n), b_tilde(n);
+
+    for (int i = 1; i < N; i++)
+    {
+        const double h_left = x[i] - x[i - 1];
+        const double h_right = x[i + 1] - x[i];
+        const double left = p(0.5 * (x[i - 1] + x[i])) / h_left;
+        const double right = p(0.5 * (x[i] + x[i + 1])) / h_right;
+
+        // Unknown k = i - 1. NOTE: a[0] = a_1 and so on, as in general_algorithm...
+        const int k = i - 1;
+        b[k] = left + right;
+        g[k] = f(x[i]) * 0.5 * (h_left + h_right);
+        if (k > 0)
+        {
+            a[k - 1] = -left;
+        }
+        if (k < n - 1)
+        {
+            c[k] = -right;
+        }
+    }
+
+    std::vector<double> u(N + 1, 0.0);
+    if (n > 0)
+    {
+        general_algorithm(a.data(), b.data(), c.data(), g.data(), n, b_tilde.data());
+        std::copy(g.begin(), g.end(), u.begin() + 1);
+    }
+    return u;
+}
+
+AdaptiveSolution adaptive_algorithm(double (*p)(double), double (*f)(double),
+                                    double x0, double x1, double tolerance,
+                                    int n_initial, int max_refinements)
+{
+    std::vector<double> x(n_initial + 1);
+    for (int i = 0; i <= n_initial; i++)
+    {
+        x[i] = x0 + (x1 - x0) * i / n_initial;
+    }
+
+    AdaptiveSolution solution;
+
+    for (int refinement = 0; ; refinement++)
+    {
+        const int N = x.size() - 1;
+        std::vector<double> u = nonuniform_algorithm(x, p, f);
+        std::vector<double> x_fine = bisect(x);
+        std::vector<double> u_fine = nonuniform_algorithm(x_fine, p, f);
+
+        // The bisected mesh has (about) a quarter of the error, so |u_fine - u| ~ |u_h - u_{h/2}|/3:
+        double max_rel_error = 0;
+        for (int i = 1; i < N; i++)
+        {
+            if (u_fine[2 * i] != 0)
+            {
+                max_rel_error = std::max(max_rel_error, std::abs(u[i] - u_fine[2 * i]) / (3 * std::abs(u_fine[2 * i])));
+            }
+        }
+
+        solution.x = x_fine;
+        solution.u = u_fine;
+        solution.estimated_error = max_rel_error;
+        solution.refinements = refinement;
+
+        if (max_rel_error <= tolerance || refinement == max_refinements)
+        {
+            return solution;
+        }
+
+        // Second order, so the number of elements needed is about N (error/tolerance)^(1/2).
+        // With 10 % to spare, but at most 10 times as many per step, as the first meshes are crude:
+        const int N_new = std::min(10.0 * N, std::ceil(1.1 * N * std::sqrt(max_rel_error / tolerance)));
+
+        // Monitor |u''|^(1/3), with a small floor so that no part of the interval is left empty:
+        std::vector<double> u_xx = second_derivative(x_fine, u_fine);
+        const double floor = 1e-3 * *std::max_element(u_xx.begin(), u_xx.end());
+
+        std::vector<double> monitor(u_xx.size());
+        for (int i = 0; i < monitor.size(); i++)
+        {
+            monitor[i] = std::cbrt(u_xx[i] + floor);
+        }
+        x = equidistribute(x_fine, monitor, N_new);
+    }
+}
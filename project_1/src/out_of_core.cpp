@@ -0,0 +1,318 @@
+#include "out_of_core.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+    /**
+     * Memory map of the bytes [begin, end) of an open file. The start of the mapping is
+     * rounded down to a page boundary, as required by mmap.
+     */
+    class MappedRange
+    {
+    private:
+        void *base;
+        std::size_t length;
+        char *start;
+
+    public:
+        MappedRange(int fd, std::uint64_t begin, std::uint64_t end, bool writable)
+        {
+            static const std::uint64_t page_size = sysconf(_SC_PAGESIZE);
+            const std::uint64_t offset = begin - begin % page_size;
+
+            length = end - offset;
+            base = mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                        MAP_SHARED, fd, offset);
+            if (base == MAP_FAILED)
+            {
+                throw std::runtime_error("out_of_core_algorithm: mmap failed");
+            }
+            madvise(base, length, MADV_WILLNEED);
+
+            start = static_cast<char *>(base) + (begin - offset);
+        }
+
+        ~MappedRange()
+        {
+            munmap(base, length);
+        }
+
+        MappedRange(const MappedRange &) = delete;
+        MappedRange &operator=(const MappedRange &) = delete;
+
+        double *data() const
+        {
+            return reinterpret_cast<double *>(start);
+        }
+    };
+
+    /**
+     * An open file, closed (and for a scratch file removed) when it goes out of scope,
+     * also when an exception is thrown. With O_CREAT the file is resized to `size` bytes.
+     */
+    class OpenFile
+    {
+    private:
+        std::string remove_filename;
+
+    public:
+        int fd;
+
+        OpenFile(const std::string &filename, int flags, std::uint64_t size = 0, bool remove = false)
+        {
+            fd = open(filename.c_str(), flags, 0644);
+            if (fd < 0)
+            {
+                throw std::runtime_error("out_of_core_algorithm: Could not open " + filename);
+            }
+            if (remove)
+            {
+                remove_filename = filename;
+            }
+            if ((flags & O_CREAT) && ftruncate(fd, size) != 0)
+            {
+                close(fd);              // (the destructor does not run when the constructor throws)
+                if (remove)
+                {
+                    unlink(filename.c_str());
+                }
+                throw std::runtime_error("out_of_core_algorithm: Could not resize " + filename);
+            }
+        }
+
+        ~OpenFile()
+        {
+            close(fd);
+            if (!remove_filename.empty())
+            {
+                unlink(remove_filename.c_str());
+            }
+        }
+
+        OpenFile(const OpenFile &) = delete;
+        OpenFile &operator=(const OpenFile &) = delete;
+
+        /**
+         * Number of doubles in the file.
+         */
+        long long n_doubles(const std::string &filename) const
+        {
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) != 0)
+            {
+                throw std::runtime_error("out_of_core_algorithm: Could not stat " + filename);
+            }
+            return file_stat.st_size / sizeof(double);
+        }
+    };
+
+    /**
+     * Diagonals with constant entries.
+     */
+    struct ConstantDiagonals
+    {
+        double a_value, b_value, c_value;
+
+        void map(long long, long long, bool) {}
+
+        double a(long long) const { return a_value; }
+        double b(long long) const { return b_value; }
+        double c(long long) const { return c_value; }
+    };
+
+    /**
+     * Diagonals streamed from files of raw doubles, a chunk of rows at a time. In row i,
+     * a(i) = a[i - 1] (i >= 1), b(i) = b[i] and c(i) = c[i] (i <= n - 2), as in general_algorithm.
+     */
+    class MappedDiagonals
+    {
+    private:
+        const OpenFile &a_file, &b_file, &c_file;
+        const long long n;
+        std::unique_ptr<MappedRange> a_range, b_range, c_range;
+        const double *a_data = nullptr, *b_data = nullptr, *c_data = nullptr;
+        long long a_first = 0, b_first = 0, c_first = 0;        // Index of the first mapped element
+
+        /**
+         * Maps the elements [first, last) of `file`, if there are any.
+         */
+        static void map_range(const OpenFile &file, long long first, long long last,
+                              std::unique_ptr<MappedRange> &range, const double *&data)
+        {
+            range.reset();
+            data = nullptr;
+            if (first < last)
+            {
+                range.reset(new MappedRange(file.fd, first * sizeof(double), last * sizeof(double), false));
+                data = range->data();
+            }
+        }
+
+    public:
+        MappedDiagonals(const OpenFile &a_file, const OpenFile &b_file, const OpenFile &c_file, long long n):
+            a_file(a_file), b_file(b_file), c_file(c_file), n(n)
+        {
+        }
+
+        /**
+         * Maps what rows [start, end) need: a, b and c(i - 1) in the forward sweep, c(i) in the backward sweep.
+         */
+        void map(long long start, long long end, bool forward)
+        {
+            if (forward)
+            {
+                a_first = std::max(start, 1LL) - 1;
+                b_first = start;
+                c_first = a_first;
+                map_range(a_file, a_first, end - 1, a_range, a_data);
+                map_range(b_file, b_first, end, b_range, b_data);
+                map_range(c_file, c_first, end - 1, c_range, c_data);
+            }
+            else
+            {
+                a_range.reset();
+                b_range.reset();
+                c_first = start;
+                map_range(c_file, c_first, std::min(end, n - 1), c_range, c_data);
+            }
+        }
+
+        double a(long long i) const { return a_data[i - 1 - a_first]; }
+        double b(long long i) const { return b_data[i - b_first]; }
+        double c(long long i) const { return c_data[i - c_first]; }
+    };
+
+    /**
+     * The two sweeps of out_of_core_algorithm, for any kind of diagonals.
+     */
+    template <class Diagonals>
+    long long sweeps(Diagonals &diagonals, const OpenFile &rhs_file, long long n,
+                     const std::string &out_filename, const std::string &scratch_filename,
+                     double x_start, double h, long long chunk)
+    {
+        if (chunk < 1)
+        {
+            throw std::runtime_error("out_of_core_algorithm: chunk must be at least 1");
+        }
+
+        const std::uint64_t point_size = 2 * sizeof(double);     // (x, v) in the output, (g_tilde, 1/b_tilde) in the scratch
+        const std::uint64_t header_size = sizeof(std::uint64_t);
+
+        OpenFile out_file(out_filename, O_RDWR | O_CREAT | O_TRUNC, header_size + n * point_size);
+        const std::uint64_t n_points = n;
+        if (pwrite(out_file.fd, &n_points, header_size, 0) != static_cast<ssize_t>(header_size))
+        {
+            throw std::runtime_error("out_of_core_algorithm: Could not write to " + out_filename);
+        }
+
+        if (n == 0)
+        {
+            return 0;
+        }
+
+        OpenFile scratch_file(scratch_filename, O_RDWR | O_CREAT | O_TRUNC, n * point_size, true);
+
+        // Forward sweep. The first row has no lower diagonal entry, so its multiplier is 0:
+        double g_tilde_prev = 0;
+        double inv_b_tilde_prev = 0;
+
+        for (long long start = 0; start < n; start += chunk)
+        {
+            const long long length = std::min(chunk, n - start);
+            MappedRange rhs(rhs_file.fd, start * sizeof(double), (start + length) * sizeof(double), false);
+            MappedRange scratch(scratch_file.fd, start * point_size, (start + length) * point_size, true);
+            diagonals.map(start, start + length, true);
+
+            const double *g = rhs.data();
+            double *state = scratch.data();
+
+            for (long long k = 0; k < length; k++)
+            {
+                const long long i = start + k;
+                const double multiplier = (i == 0) ? 0.0 : diagonals.a(i) * inv_b_tilde_prev;
+                const double inv_b_tilde = 1 / (diagonals.b(i) - multiplier * ((i == 0) ? 0.0 : diagonals.c(i - 1)));
+                const double g_tilde = g[k] - multiplier * g_tilde_prev;
+
+                state[2 * k] = g_tilde;
+                state[2 * k + 1] = inv_b_tilde;
+
+                g_tilde_prev = g_tilde;
+                inv_b_tilde_prev = inv_b_tilde;
+            }
+        }
+
+        // Backward sweep over the same chunks in reverse, with v_n = 0 for the last row:
+        double v_next = 0;
+
+        for (long long end = n; end > 0; end -= chunk)
+        {
+            const long long start = std::max(0LL, end - chunk);
+            MappedRange scratch(scratch_file.fd, start * point_size, end * point_size, false);
+            MappedRange out(out_file.fd, header_size + start * point_size, header_size + end * point_size, true);
+            diagonals.map(start, end, false);
+
+            const double *state = scratch.data();
+            double *points = out.data();
+
+            for (long long k = end - start - 1; k >= 0; k--)
+            {
+                const long long i = start + k;
+                const double v = (state[2 * k] - ((i == n - 1) ? 0.0 : diagonals.c(i)) * v_next) * state[2 * k + 1];
+
+                points[2 * k] = x_start + i * h;
+                points[2 * k + 1] = v;
+
+                v_next = v;
+            }
+        }
+
+        return n;
+    }
+}
+
+long long out_of_core_algorithm(const std::string &a_filename,
+                                const std::string &b_filename,
+                                const std::string &c_filename,
+                                const std::string &rhs_filename,
+                                const std::string &out_filename,
+                                const std::string &scratch_filename,
+                                double x_start, double h, long long chunk)
+{
+    OpenFile rhs_file(rhs_filename, O_RDONLY);
+    OpenFile a_file(a_filename, O_RDONLY);
+    OpenFile b_file(b_filename, O_RDONLY);
+    OpenFile c_file(c_filename, O_RDONLY);
+
+    const long long n = rhs_file.n_doubles(rhs_filename);
+    const long long n_offdiagonal = std::max(n - 1, 0LL);
+    if (b_file.n_doubles(b_filename) != n || a_file.n_doubles(a_filename) != n_offdiagonal
+        || c_file.n_doubles(c_filename) != n_offdiagonal)
+    {
+        throw std::runtime_error("out_of_core_algorithm: The diagonals must have n - 1, n and n - 1 elements");
+    }
+
+    MappedDiagonals diagonals(a_file, b_file, c_file, n);
+    return sweeps(diagonals, rhs_file, n, out_filename, scratch_filename, x_start, h, chunk);
+}
+
+long long out_of_core_algorithm(double a, double b, double c,
+                                const std::string &rhs_filename,
+                                const std::string &out_filename,
+                                const std::string &scratch_filename,
+                                double x_start, double h, long long chunk)
+{
+    OpenFile rhs_file(rhs_filename, O_RDONLY);
+    const long long n = rhs_file.n_doubles(rhs_filename);
+
+    ConstantDiagonals diagonals = {a, b, c};
+    return sweeps(diagonals, rhs_file, n, out_filename, scratch_filename, x_start, h, chunk);
+}
@@ -0,0 +1,135 @@
+
+#include "output_writer.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+OutputWriter::OutputWriter(std::string filename, int stride, std::size_t buffer_size)
+    : filename(filename), stride(stride < 1 ? 1 : stride), buffer(buffer_size)
+{
+    binary = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+
+    file = std::fopen(filename.c_str(), binary ? "wb" : "w");
+    if (file == nullptr)
+    {
+        throw std::runtime_error("OutputWriter: Could not open " + filename);
+    }
+
+    // We use our own buffer instead:
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    if (binary)
+    {
+        // Placeholder for the number of points, filled in by close()
+        if (std::fwrite(&n_written, sizeof(n_written), 1, file) != 1)
+        {
+            failed = true;
+        }
+    }
+}
+
+OutputWriter::~OutputWriter()
+{
+    // A destructor cannot throw, so errors are only reported by calling close() explicitly
+    try
+    {
+        close();
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+}
+
+void OutputWriter::write(double x, double y)
+{
+    if (n_given % stride == 0)
+    {
+        write_point(x, y);
+        last_written = true;
+    }
+    else
+    {
+        last_written = false;
+    }
+
+    last_x = x;
+    last_y = y;
+    n_given++;
+}
+
+void OutputWriter::write_point(double x, double y)
+{
+    // Longest text line is 2 * 21 characters + ",\n"
+    if (buffer.size() - used < 64)
+    {
+        flush();
+    }
+
+    if (binary)
+    {
+        double point[2] = {x, y};
+        std::memcpy(buffer.data() + used, point, sizeof(point));
+        used += sizeof(point);
+    }
+    else
+    {
+        // Same format as setprecision(14) and std::scientific
+        used += std::snprintf(buffer.data() + used, buffer.size() - used, "%.14e,%.14e\n", x, y);
+    }
+
+    n_written++;
+}
+
+void OutputWriter::flush()
+{
+    if (used > 0)
+    {
+        if (std::fwrite(buffer.data(), 1, used, file) != used)
+        {
+            failed = true;
+        }
+        used = 0;
+    }
+}
+
+void OutputWriter::close()
+{
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    if (n_given > 0 && not last_written)
+    {
+        write_point(last_x, last_y);
+    }
+    flush();
+
+    if (binary)
+    {
+        if (std::fseek(file, 0, SEEK_SET) != 0 || std::fwrite(&n_written, sizeof(n_written), 1, file) != 1)
+        {
+            failed = true;
+        }
+    }
+
+    if (std::fclose(file) != 0)
+    {
+        failed = true;
+    }
+    file = nullptr;
+
+    if (failed)
+    {
+        throw std::runtime_error("OutputWriter: Could not write " + filename + " (disk full?)");
+    }
+}
+
+int decimation_stride(long long n_points, long long target)
+{
+    if (target <= 0 || target >= n_points)
+    {
+        return 1;
+    }
+    return static_cast<int>((n_points + target - 1) / target);
+}
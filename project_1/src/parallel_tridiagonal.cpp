@@ -0,0 +1,190 @@
+
+#include "parallel_tridiagonal.hpp"
+#include "tridiagonal_algorithms.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /**
+     * The spikes a_w and c_w decay geometrically away from the block edges. Flushing them
+     * to zero before they become subnormal avoids the (very slow) subnormal arithmetic.
+     */
+    inline double flush(double x)
+    {
+        return (std::abs(x) < std::numeric_limits<double>::min()) ? 0.0 : x;
+    }
+
+    /**
+     * Modified Thomas algorithm on the block of rows [s, e). Afterwards, every row i in
+     * the block reads  a_w[i] x_first + x_i + c_w[i] x_last = g[i],  except for the first
+     * and last row, which couple to the last row of the previous block and the first row
+     * of the next block respectively.
+     */
+    void eliminate_block(const double *a, const double *b, const double *c, double *g,
+                         double *a_w, double *c_w, int n, int s, int e)
+    {
+        // Coupling coefficients of the first and last row, where a[0] = a_1 and so on...
+        const double a_first = (s == 0) ? 0.0 : a[s - 1];
+        const double c_last = (e == n) ? 0.0 : c[e - 1];
+
+        // Forward sweep (first two rows are only normalized):
+        double r = 1.0 / b[s];
+        a_w[s] = a_first * r;
+        c_w[s] = c[s] * r;
+        g[s] *= r;
+
+        r = 1.0 / b[s + 1];
+        a_w[s + 1] = a[s] * r;
+        c_w[s + 1] = c[s + 1] * r;
+        g[s + 1] *= r;
+
+        for (int i = s + 2; i < e - 1; i++)
+        {
+            r = 1.0 / (b[i] - a[i - 1] * c_w[i - 1]);
+            g[i] = r * (g[i] - a[i - 1] * g[i - 1]);
+            a_w[i] = flush(-r * a[i - 1] * a_w[i - 1]);
+            c_w[i] = r * c[i];
+        }
+
+        r = 1.0 / (b[e - 1] - a[e - 2] * c_w[e - 2]);
+        g[e - 1] = r * (g[e - 1] - a[e - 2] * g[e - 2]);
+        a_w[e - 1] = -r * a[e - 2] * a_w[e - 2];
+        c_w[e - 1] = r * c_last;
+
+        // Backward sweep, expressing the rows in terms of x_last instead of x_{i+1}:
+        for (int i = e - 3; i > s; i--)
+        {
+            g[i] -= c_w[i] * g[i + 1];
+            a_w[i] -= c_w[i] * a_w[i + 1];
+            c_w[i] = flush(-c_w[i] * c_w[i + 1]);
+        }
+
+        r = 1.0 / (1.0 - c_w[s] * a_w[s + 1]);
+        g[s] = r * (g[s] - c_w[s] * g[s + 1]);
+        a_w[s] = r * a_w[s];
+        c_w[s] = -r * c_w[s] * c_w[s + 1];
+    }
+
+    /**
+     * Recovers the interior of the block [s, e) once x_first and x_last are known.
+     */
+    void substitute_block(double *g, const double *a_w, const double *c_w, int s, int e)
+    {
+        const double x_first = g[s];
+        const double x_last = g[e - 1];
+
+        for (int i = s + 1; i < e - 1; i++)
+        {
+            g[i] -= a_w[i] * x_first + c_w[i] * x_last;
+        }
+    }
+
+    template <typename Function>
+    void for_each_block(int n_blocks, Function function)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(n_blocks - 1);
+
+        for (int p = 1; p < n_blocks; p++)
+        {
+            threads.emplace_back(function, p);
+        }
+        function(0);
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+std::vector<double> parallel_general_algorithm(const std::vector<double> &a,
+                                               const std::vector<double> &b,
+                                               const std::vector<double> &c,
+                                               const std::vector<double> &g,
+                                               int n_threads)
+{
+    int n = b.size();
+
+    std::vector<double> solution = g;
+    std::vector<double> workspace(2 * n);
+
+    parallel_general_algorithm(a.data(), b.data(), c.data(), solution.data(), n, workspace.data(), n_threads);
+
+    return solution;
+}
+
+void parallel_general_algorithm(const double *a,
+                                const double *b,
+                                const double *c,
+                                double *g,
+                                int n,
+                                double *workspace,
+                                int n_threads)
+{
+    // Every block needs at least three rows:
+    int n_blocks = std::max(1, std::min(n_threads, n / 3));
+
+    if (n_blocks == 1)
+    {
+        general_algorithm(a, b, c, g, n, workspace);
+        return;
+    }
+
+    double *a_w = workspace;
+    double *c_w = workspace + n;
+
+    // Block p consists of the rows [start[p], start[p + 1]):
+    std::vector<int> start(n_blocks + 1);
+    for (int p = 0; p <= n_blocks; p++)
+    {
+        start[p] = static_cast<int>(static_cast<long long>(n) * p / n_blocks);
+    }
+
+    for_each_block(n_blocks, [&](int p) {
+        eliminate_block(a, b, c, g, a_w, c_w, n, start[p], start[p + 1]);
+    });
+
+    // Reduced system for the unknowns (x_first, x_last) of every block:
+    int m = 2 * n_blocks;
+    std::vector<double> a_r(m - 1);
+    std::vector<double> b_r(m, 1.0);
+    std::vector<double> c_r(m - 1);
+    std::vector<double> g_r(m);
+    std::vector<double> b_tilde_r(m);
+
+    for (int p = 0; p < n_blocks; p++)
+    {
+        int first = start[p];
+        int last = start[p + 1] - 1;
+
+        g_r[2 * p] = g[first];
+        g_r[2 * p + 1] = g[last];
+
+        if (p > 0)
+        {
+            a_r[2 * p - 1] = a_w[first];
+        }
+        c_r[2 * p] = c_w[first];
+        a_r[2 * p] = a_w[last];
+        if (p < n_blocks - 1)
+        {
+            c_r[2 * p + 1] = c_w[last];
+        }
+    }
+
+    general_algorithm(a_r.data(), b_r.data(), c_r.data(), g_r.data(), m, b_tilde_r.data());
+
+    for (int p = 0; p < n_blocks; p++)
+    {
+        g[start[p]] = g_r[2 * p];
+        g[start[p + 1] - 1] = g_r[2 * p + 1];
+    }
+
+    for_each_block(n_blocks, [&](int p) {
+        substitute_block(g, a_w, c_w, start[p], start[p + 1]);
+    });
+}
@@ -0,0 +1,127 @@
+
+#include "toeplitz_solver.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+template <typename T>
+ToeplitzSolver<T>::ToeplitzSolver(T a, T b, T c, int n) : a(a), b(b), c(c), n(n)
+{
+    const T eps = std::numeric_limits<T>::epsilon();
+    const T discriminant = b * b - 4 * a * c;
+
+    closed_form = std::abs(discriminant) <= eps * b * b;
+    if (closed_form)
+    {
+        return;
+    }
+
+    // Limit of the pivots (the root of x^2 - bx + ac with the same sign as b), if it exists:
+    bool converging = discriminant > 0;
+    T b_limit = b;
+    if (converging)
+    {
+        b_limit = (b + std::copysign(std::sqrt(discriminant), b)) / 2;
+    }
+
+    T b_tilde = b;
+    inv_b_tilde.push_back(1 / b_tilde);
+
+    for (int i = 1; i < n; i++)
+    {
+        if (converging && std::abs(b_tilde - b_limit) <= eps * std::abs(b_limit))
+        {
+            break;
+        }
+        b_tilde = b - a * c / b_tilde;
+        inv_b_tilde.push_back(1 / b_tilde);
+    }
+
+    inv_b_limit = converging ? 1 / b_limit : inv_b_tilde.back();
+}
+
+template <typename T>
+int ToeplitzSolver<T>::table_size() const
+{
+    return inv_b_tilde.size();
+}
+
+template <typename T>
+void ToeplitzSolver<T>::solve(T *g) const
+{
+    if (closed_form)
+    {
+        solve_closed_form(g);
+    }
+    else
+    {
+        solve_tabulated(g);
+    }
+}
+
+template <typename T>
+std::vector<T> ToeplitzSolver<T>::solve(std::vector<T> g) const
+{
+    solve(g.data());
+    return g;
+}
+
+template <typename T>
+void ToeplitzSolver<T>::solve_closed_form(T *g) const
+{
+    // 1/b_tilde_i = (2/b)(i + 1)/(i + 2). The factors are computed off the dependency
+    // chain through g, so the divisions overlap instead of adding to the latency.
+    const T two_over_b = 2 / b;
+    const T two_a_over_b = 2 * a / b;
+
+    for (int i = 1; i < n; i++)
+    {
+        const T multiplier = two_a_over_b * i / (i + 1);
+        g[i] -= multiplier * g[i - 1];
+    }
+
+    g[n - 1] *= two_over_b * n / (n + 1);
+
+    for (int i = n - 2; i >= 0; i--)
+    {
+        const T inv_b_tilde_i = two_over_b * (i + 1) / (i + 2);
+        g[i] = (g[i] - c * g[i + 1]) * inv_b_tilde_i;
+    }
+}
+
+template <typename T>
+void ToeplitzSolver<T>::solve_tabulated(T *g) const
+{
+    const int m = std::min<int>(inv_b_tilde.size(), n);
+    const T *inv = inv_b_tilde.data();
+
+    // Forward sweep, first with the tabulated pivots and then with the limit:
+    for (int i = 1; i < std::min(m + 1, n); i++)
+    {
+        g[i] -= a * inv[i - 1] * g[i - 1];
+    }
+
+    const T a_inv_limit = a * inv_b_limit;
+    for (int i = m + 1; i < n; i++)
+    {
+        g[i] -= a_inv_limit * g[i - 1];
+    }
+
+    // Backward sweep, in the opposite order:
+    g[n - 1] *= (n - 1 < m) ? inv[n - 1] : inv_b_limit;
+
+    for (int i = n - 2; i >= m; i--)
+    {
+        g[i] = (g[i] - c * g[i + 1]) * inv_b_limit;
+    }
+
+    for (int i = std::min(m, n - 1) - 1; i >= 0; i--)
+    {
+        g[i] = (g[i] - c * g[i + 1]) * inv[i];
+    }
+}
+
+template class ToeplitzSolver<float>;
+template class ToeplitzSolver<double>;
+template class ToeplitzSolver<long double>;
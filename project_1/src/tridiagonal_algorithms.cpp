@@ -1,23 +1,27 @@
 
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <string>
 #include <iomanip>
 #include <iostream>
 
-std::vector<double> general_algorithm(std::vector<double> a,
-                                     std::vector<double> b,
-                                     std::vector<double> c,
-                                     std::vector<double> g)
+#include "tridiagonal_algorithms.hpp"
+
+template <typename T>
+std::vector<T> general_algorithm(const std::vector<T> &a,
+                                 const std::vector<T> &b,
+                                 const std::vector<T> &c,
+                                 const std::vector<T> &g)
 {
 
     // Initialize vectors:
     int n = b.size();
 
-    std::vector<double> b_tilde(n);
-    std::vector<double> g_tilde(n);
-    std::vector<double> solution(n + 2);
+    std::vector<T> b_tilde(n);
+    std::vector<T> g_tilde(n);
+    std::vector<T> solution(n + 2);
 
     b_tilde[0] = b[0];
     g_tilde[0] = g[0];
@@ -26,7 +30,7 @@ std::vector<double> general_algorithm(std::vector<double> a,
     for (int i = 1; i < n; i++)
     {   
         // NOTE: Index a with (i-1) instead of (i), as a[0] = a_1 and so on...
-        double temp = a[i - 1] / b_tilde[i - 1];        // Temporary variable for -n FLOPS
+        T temp = a[i - 1] / b_tilde[i - 1];        // Temporary variable for -n FLOPS
         b_tilde[i] = b[i] - temp * c[i - 1];
         g_tilde[i] = g[i] - temp * g_tilde[i - 1];
     }
@@ -42,33 +46,140 @@ std::vector<double> general_algorithm(std::vector<double> a,
     return solution;
 }
 
-std::vector<double> special_algorithm(std::vector<double> g)
+template <typename T>
+std::vector<T> special_algorithm(const std::vector<T> &g)
 {
-
-    // Initialize vectors:
+    // Solved in place on a copy, with room for the boundaries:
     int n = g.size();
+    std::vector<T> solution(n + 2);
+    std::copy(g.begin(), g.end(), solution.begin() + 1);
 
-    std::vector<double> g_tilde(n);
-    std::vector<double> b_tilde(n);
-    std::vector<double> solution(n + 2);
+    special_algorithm(solution.data() + 1, n);
 
-    g_tilde[0] = g[0];
-    b_tilde[0] = 2;
+    return solution;
+}
+
+template <typename T>
+void general_algorithm(const T *a,
+                       const T *b,
+                       const T *c,
+                       T *g,
+                       int n,
+                       T *b_tilde)
+{
+    // g is overwritten by g_tilde in the forward sweep:
+    b_tilde[0] = b[0];
 
-    // Find g_tilde algorithmically:
     for (int i = 1; i < n; i++)
     {
-        b_tilde[i] = 1.0 + 1.0/i;
-        g_tilde[i] = g[i] + g_tilde[i - 1] / b_tilde[i - 1];
+        // NOTE: Index a with (i-1) instead of (i), as a[0] = a_1 and so on...
+        T temp = a[i - 1] / b_tilde[i - 1];
+        b_tilde[i] = b[i] - temp * c[i - 1];
+        g[i] = g[i] - temp * g[i - 1];
     }
 
-    // Use these to find solution vector v;
-    solution[n - 1] = g_tilde[n - 1] / b_tilde[n - 1];
+    // ... and then by the solution v in the backward sweep:
+    g[n - 1] = g[n - 1] / b_tilde[n - 1];
 
-    for (int i = n - 2; i >= 1; i--)
+    for (int i = n - 2; i >= 0; i--)
     {
-        solution[i] = (g_tilde[i] + solution[i + 1]) / b_tilde[i];
+        g[i] = (g[i] - c[i] * g[i + 1]) / b_tilde[i];
     }
+}
 
-    return solution;
-}
\ No newline at end of file
+template <typename T>
+void special_algorithm(T *g, int n)
+{
+    // Forward sweep, using b_tilde_{i-1} = (i + 1)/i:
+    for (int i = 1; i < n; i++)
+    {
+        g[i] = g[i] + g[i - 1] * i / (i + 1);
+    }
+
+    // Backward sweep, using 1/b_tilde_i = (i + 1)/(i + 2):
+    g[n - 1] = g[n - 1] * n / (n + 1);
+
+    for (int i = n - 2; i >= 0; i--)
+    {
+        g[i] = (g[i] + g[i + 1]) * (i + 1) / (i + 2);
+    }
+}
+
+template <typename T>
+void streaming_special_algorithm(double (*source)(double), double x0, double x1, int n_steps, T *v, bool numerov)
+{
+    const int n = n_steps - 1;          // ( matrix eq. does not include the boundaries )
+    const double h = (x1 - x0) / n_steps;
+    const double h2 = h * h;
+
+    v[0] = 0;
+    v[n_steps] = 0;
+    if (n <= 0)
+    {
+        return;         // (no unknowns, and v[1] is the boundary)
+    }
+
+    // Right hand side of unknown j, i.e. at x_{j+1}, with f_left and f_mid = f(x_j) and f(x_{j+1}):
+    double f_left = numerov ? source(x0) : 0.0;
+    double f_mid = source(x0 + h);
+
+    auto rhs = [&](int j) {
+        if (not numerov)
+        {
+            return (j == 0) ? h2 * f_mid : h2 * source(x0 + (j + 1) * h);
+        }
+        const double f_right = source(x0 + (j + 2) * h);
+        const double g = h2 * (f_left + 10 * f_mid + f_right) / 12;
+        f_left = f_mid;
+        f_mid = f_right;
+        return g;
+    };
+
+    // Forward sweep, with unknown j stored in v[j + 1] and g evaluated on the fly:
+    v[1] = T(rhs(0));
+
+    for (int j = 1; j < n; j++)
+    {
+        v[j + 1] = T(rhs(j)) + v[j] * j / (j + 1);
+    }
+
+    // Backward sweep, same as in the in-place special algorithm:
+    v[n] = v[n] * n / (n + 1);
+
+    for (int j = n - 2; j >= 0; j--)
+    {
+        v[j + 1] = (v[j + 1] + v[j + 2]) * (j + 1) / (j + 2);
+    }
+}
+
+template <typename T>
+void numerov_rhs(double (*source)(double), double x0, double x1, int n_steps, T *g)
+{
+    const double h = (x1 - x0) / n_steps;
+    const double h2_over_12 = h * h / 12;
+
+    double f_left = source(x0);
+    double f_mid = source(x0 + h);
+
+    for (int j = 0; j < n_steps - 1; j++)
+    {
+        const double f_right = source(x0 + (j + 2) * h);
+        g[j] = T(h2_over_12 * (f_left + 10 * f_mid + f_right));
+        f_left = f_mid;
+        f_mid = f_right;
+    }
+}
+
+// Explicit instantiations for the supported precisions:
+#define INSTANTIATE_TRIDIAGONAL_ALGORITHMS(T)                                                       \
+    template std::vector<T> general_algorithm(const std::vector<T> &, const std::vector<T> &,       \
+                                              const std::vector<T> &, const std::vector<T> &);      \
+    template std::vector<T> special_algorithm(const std::vector<T> &);                              \
+    template void general_algorithm(const T *, const T *, const T *, T *, int, T *);                \
+    template void special_algorithm(T *, int);                                                      \
+    template void streaming_special_algorithm(double (*)(double), double, double, int, T *, bool);  \
+    template void numerov_rhs(double (*)(double), double, double, int, T *);
+
+INSTANTIATE_TRIDIAGONAL_ALGORITHMS(float)
+INSTANTIATE_TRIDIAGONAL_ALGORITHMS(double)
+INSTANTIATE_TRIDIAGONAL_ALGORITHMS(long double)
@@ -0,0 +1,73 @@
+
+#include "tridiagonal_factorization.hpp"
+
+TridiagonalFactorization::TridiagonalFactorization(const std::vector<double> &a,
+                                                   const std::vector<double> &b,
+                                                   const std::vector<double> &c)
+    : n(b.size()), c(c), multiplier(b.size()), inv_b_tilde(b.size())
+{
+    // Same forward sweep as in general_algorithm, but only for b_tilde:
+    double b_tilde = b[0];
+    inv_b_tilde[0] = 1.0 / b_tilde;
+    multiplier[0] = 0;
+
+    for (int i = 1; i < n; i++)
+    {
+        // NOTE: Index a and c with (i-1), as a[0] = a_1 and so on...
+        multiplier[i] = a[i - 1] * inv_b_tilde[i - 1];
+        b_tilde = b[i] - multiplier[i] * c[i - 1];
+        inv_b_tilde[i] = 1.0 / b_tilde;
+    }
+}
+
+int TridiagonalFactorization::size() const
+{
+    return n;
+}
+
+std::vector<double> TridiagonalFactorization::solve(std::vector<double> g) const
+{
+    solve_many(g.data(), 1);
+    return g;
+}
+
+void TridiagonalFactorization::solve_many(std::vector<double> &G, int n_rhs) const
+{
+    solve_many(G.data(), n_rhs);
+}
+
+void TridiagonalFactorization::solve_many(double *G, int n_rhs) const
+{
+    // Find g_tilde for all columns, row by row:
+    for (int i = 1; i < n; i++)
+    {
+        const double m = multiplier[i];
+        const double *previous = G + std::size_t(i - 1) * n_rhs;
+        double *row = G + std::size_t(i) * n_rhs;
+
+        for (int j = 0; j < n_rhs; j++)
+        {
+            row[j] -= m * previous[j];
+        }
+    }
+
+    // Back substitution, again row by row:
+    double *last = G + std::size_t(n - 1) * n_rhs;
+    for (int j = 0; j < n_rhs; j++)
+    {
+        last[j] *= inv_b_tilde[n - 1];
+    }
+
+    for (int i = n - 2; i >= 0; i--)
+    {
+        const double c_i = c[i];
+        const double inv_b = inv_b_tilde[i];
+        const double *next = G + std::size_t(i + 1) * n_rhs;
+        double *row = G + std::size_t(i) * n_rhs;
+
+        for (int j = 0; j < n_rhs; j++)
+        {
+            row[j] = (row[j] - c_i * next[j]) * inv_b;
+        }
+    }
+}
@@ -1,21 +1,16 @@
 
 #include "utils.hpp"
+#include "output_writer.hpp"
 
-void write_to_file(std::vector<double> x, std::vector<double> y, std::string filename)
+void write_to_file(const std::vector<double> &x, const std::vector<double> &y, std::string filename, int stride)
 {
-    int prec = 14;
-
-    std::ofstream ofile;
-    ofile.open(filename);
+    OutputWriter writer(filename, stride);
 
     for (int i = 0; i < x.size(); i++)
     {
-        ofile << std::setprecision(prec) << std::scientific << x[i]
-              << ","
-              << std::setprecision(prec) << std::scientific << y[i]
-              << std::endl;
+        writer.write(x[i], y[i]);
     }
-    ofile.close();
+    writer.close();
 }
 
 double source_term(double x)
@@ -5,54 +5,315 @@
 #include <iomanip>
 #include <iostream>
 #include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <stdexcept>
 
 #include "utils.hpp"
+#include "arg_parser.hpp"
+#include "output_writer.hpp"
 #include "tridiagonal_algorithms.hpp"
+#include "out_of_core.hpp"
+#include "dst_poisson.hpp"
+#include "nonuniform_mesh.hpp"
 
-int main(int argc, char* argv[])
+/**
+ * Solves the Poisson equation with the Thomas algorithm in precision T, and writes the solution.
+ */
+template <typename T>
+void solve(const Args &args)
 {
-    if (argc != 3)
+    int steps = args.n_steps;          // (no. of steps in the FULL solution)
+    std::string filename = args.filename;
+    const T x0 = 0.0;
+    const T x1 = 1.0;
+    const T h = (x1 - x0) / steps;
+
+    if (args.numerov)
     {
-        std::string executable_name = argv[0];
-        std::cerr << "Error: Wrong number of input arguments.\n";
-        std::cerr << "Usage: " << executable_name << " <step number> <filename>\n";
-        return 1;
-    }
+        // Fourth order right hand side, solved in place for the n = steps - 1 unknowns:
+        int n = steps - 1;
+        std::vector<T> a(n - 1, -1.0);
+        std::vector<T> b(n, 2.0);
+        std::vector<T> c(n - 1, -1.0);
+        std::vector<T> b_tilde(n);
+        std::vector<T> v(n);
+        numerov_rhs(source_term, x0, x1, steps, v.data());
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        general_algorithm(a.data(), b.data(), c.data(), v.data(), n, b_tilde.data());
+
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+        std::cout << "Elapsed time: " << duration_seconds << " s\n";
 
-    int steps = std::stod(argv[1]);          // (no. of steps in the FULL solution)
-    std::string filename = argv[2];
-    const double x0 = 0.0;
-    const double x1 = 1.0;
-    const double h = (x1 - x0) / steps;
+        OutputWriter writer(filename, decimation_stride(steps + 1, args.n_points));
+        writer.write(x0, 0);
+        for (int i = 0; i < n; i++)
+        {
+            writer.write(x0 + (i + 1) * h, v[i]);
+        }
+        writer.write(x1, 0);
+        writer.close();
+
+        return;
+    }
 
     // Initialize and fill x-, v-, and g-vectors:
-    std::vector<double> x(steps + 1);
-    std::vector<double> g(steps + 1);
+    std::vector<T> x(steps + 1);
+    std::vector<T> g(steps + 1);
     x[0] = x0;
-    g[0] = h * h * source_term(0);
+    g[0] = h * h * T(source_term(0));
 
     for (int i = 1; i <= steps; i++)
     {
         x[i] = x[i-1] + h;
-        g[i] = h * h * source_term(x[i]);
+        g[i] = h * h * T(source_term(x[i]));
     }
 
 
     // Apply Thomas algorithm to find solution v, and write to file:
     
     int n = x.size() - 2;               // ( matrix eq. does not include the boundaries )
-    std::vector<double> a(n, -1.0);
-    std::vector<double> b(n + 1, 2.0);
-    std::vector<double> c(n, -1.0);
+    std::vector<T> a(n, -1.0);
+    std::vector<T> b(n + 1, 2.0);
+    std::vector<T> c(n, -1.0);
 
     auto t1 = std::chrono::high_resolution_clock::now();
     
-    std::vector<double> v = general_algorithm(a, b, c, g);
+    std::vector<T> v = general_algorithm(a, b, c, g);
     
     auto t2 = std::chrono::high_resolution_clock::now();
     double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
     std::cout << "Elapsed time: " << duration_seconds << " s\n";
 
-    // Comment out when timing algorithms:
-    // write_to_file(x, v, filename);
+    // (Use the benchmark program for proper timings)
+    OutputWriter writer(filename, decimation_stride(x.size(), args.n_points));
+    for (int i = 0; i < x.size(); i++)
+    {
+        writer.write(x[i], v[i]);
+    }
+    writer.close();
+}
+
+/**
+ * Solves the Poisson equation with out_of_core_algorithm, for n_steps too large to fit in memory.
+ * The right hand side is streamed to `<filename>.rhs` and the forward sweep to `<filename>.scratch`,
+ * both removed when done. Always in double precision, and only the unknowns are written (all of
+ * them, since decimating would need another pass over the file), so --precision and --points
+ * are rejected.
+ */
+void solve_out_of_core(const Args &args)
+{
+    const long long steps = args.n_steps;
+    const double h = 1.0 / steps;
+    const std::string rhs_filename = args.filename + ".rhs";
+
+    if (args.filename.size() < 4 || args.filename.compare(args.filename.size() - 4, 4, ".bin") != 0)
+    {
+        std::cerr << "Error: --out-of-core needs a .bin output file.\n";
+        exit(1);
+    }
+    if (args.precision != "double" || args.n_points != 0)
+    {
+        std::cerr << "Error: --out-of-core is always in double precision and writes all points (no --precision or --points).\n";
+        exit(1);
+    }
+
+    // g_i = h^2 f(x_i) (or the Numerov right hand side) for the unknowns x_i = i h, i = 1, ..., steps - 1, written in blocks:
+    std::FILE *rhs_file = std::fopen(rhs_filename.c_str(), "wb");
+    if (rhs_file == nullptr)
+    {
+        std::cerr << "Error: Could not open " << rhs_filename << ".\n";
+        exit(1);
+    }
+    std::vector<double> block(1 << 16);
+
+    for (long long start = 1; start < steps; start += block.size())
+    {
+        long long length = std::min<long long>(block.size(), steps - start);
+        for (long long k = 0; k < length; k++)
+        {
+            const long long i = start + k;
+            if (args.numerov)
+            {
+                block[k] = h * h / 12 * (source_term((i - 1) * h) + 10 * source_term(i * h) + source_term((i + 1) * h));
+            }
+            else
+            {
+                block[k] = h * h * source_term(i * h);
+            }
+        }
+        if (std::fwrite(block.data(), sizeof(double), length, rhs_file) != static_cast<std::size_t>(length))
+        {
+            std::cerr << "Error: Could not write " << rhs_filename << " (disk full?).\n";
+            std::fclose(rhs_file);
+            std::remove(rhs_filename.c_str());
+            exit(1);
+        }
+    }
+    if (std::fclose(rhs_file) != 0)
+    {
+        std::cerr << "Error: Could not write " << rhs_filename << " (disk full?).\n";
+        std::remove(rhs_filename.c_str());
+        exit(1);
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    try
+    {
+        out_of_core_algorithm(-1.0, 2.0, -1.0, rhs_filename, args.filename, args.filename + ".scratch", h, h);
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        std::remove(rhs_filename.c_str());
+        exit(1);
+    }
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "Elapsed time: " << duration_seconds << " s\n";
+
+    std::remove(rhs_filename.c_str());
+}
+
+/**
+ * Solves the Poisson equation with the sine transform solver instead of the Thomas algorithm,
+ * and writes the solution. Always in double precision.
+ */
+void solve_dst(const Args &args)
+{
+    int steps = args.n_steps;
+    const double h = 1.0 / steps;
+    int n = steps - 1;                  // ( matrix eq. does not include the boundaries )
+
+    std::vector<double> g(n);
+    if (args.numerov)
+    {
+        numerov_rhs(source_term, 0.0, 1.0, steps, g.data());
+    }
+    else
+    {
+        for (int i = 0; i < n; i++)
+        {
+            g[i] = h * h * source_term((i + 1) * h);
+        }
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    DSTPoissonSolver solver(n);
+    solver.solve(g.data());
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "Elapsed time: " << duration_seconds << " s\n";
+
+    OutputWriter writer(args.filename, decimation_stride(steps + 1, args.n_points));
+    writer.write(0, 0);
+    for (int i = 0; i < n; i++)
+    {
+        writer.write((i + 1) * h, g[i]);
+    }
+    writer.write(1, 0);
+    writer.close();
+}
+
+/**
+ * p(x) = 1, i.e. -(p u')' = f is the Poisson equation.
+ */
+double unit_coefficient(double /*x*/)
+{
+    return 1.0;
+}
+
+/**
+ * Solves the Poisson equation on an adaptively refined nonuniform mesh, starting from
+ * n_steps uniform steps, until the estimated max relative error is below args.tolerance.
+ */
+void solve_adaptive(const Args &args)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    AdaptiveSolution solution = adaptive_algorithm(unit_coefficient, source_term, 0.0, 1.0,
+                                                   args.tolerance, args.n_steps);
+
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double duration_seconds = std::chrono::duration<double>(t2 - t1).count();
+    std::cout << "Elapsed time: " << duration_seconds << " s\n";
+    std::cout << "Mesh points: " << solution.x.size() << " (after " << solution.refinements << " refinements)\n";
+    std::cout << "Estimated max relative error: " << solution.estimated_error << "\n";
+
+    OutputWriter writer(args.filename, decimation_stride(solution.x.size(), args.n_points));
+    for (int i = 0; i < solution.x.size(); i++)
+    {
+        writer.write(solution.x[i], solution.u[i]);
+    }
+    writer.close();
+}
+
+int main(int argc, char* argv[])
+{
+    Args args = parse_args(argc, argv);
+
+    // The adaptive solver has its own (second order, nonuniform) discretization:
+    if (args.numerov && args.tolerance > 0)
+    {
+        std::cerr << "Error: --numerov cannot be combined with --adaptive.\n";
+        exit(1);
+    }
+
+    // The other solvers are alternatives to each other, and only in double precision (see also solve_out_of_core):
+    if (args.out_of_core + args.dst + (args.tolerance > 0) > 1)
+    {
+        std::cerr << "Error: Only one of --out-of-core, --dst and --adaptive can be given.\n";
+        exit(1);
+    }
+    if ((args.dst || args.tolerance > 0) && args.precision != "double")
+    {
+        std::cerr << "Error: --dst and --adaptive are always in double precision (no --precision).\n";
+        exit(1);
+    }
+    if (args.stream)
+    {
+        std::cerr << "Error: --stream is only available in special_algorithm.\n";
+        exit(1);
+    }
+
+    // Report errors (e.g. an output file that cannot be written) instead of terminating:
+    try
+    {
+        if (args.out_of_core)
+        {
+            solve_out_of_core(args);
+        }
+        else if (args.dst)
+        {
+            solve_dst(args);
+        }
+        else if (args.tolerance > 0)
+        {
+            solve_adaptive(args);
+        }
+        else if (args.precision == "float")
+        {
+            solve<float>(args);
+        }
+        else if (args.precision == "long_double")
+        {
+            solve<long double>(args);
+        }
+        else
+        {
+            solve<double>(args);
+        }
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cerr << "Error: " << error.what() << "\n";
+        exit(1);
+    }
 }
\ No newline at end of file
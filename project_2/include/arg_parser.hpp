@@ -9,7 +9,7 @@
  */
 struct Args
 {
-    std::string outfile = "build/outfile.csv";  ///< Where and what to store outfile, associated to given problem (5 or 6).
+    std::string outfile = "build/outfile.csv";  ///< Where and what to store outfile, associated to given problem (5 or 6). Binary in problem 6 if it ends with ".bin".
     bool run_tests = false;                     ///< If true, runs the tests defined in "tests/".
     bool run_problem_5 = false;                 ///< If true, runs problem 5.
     bool run_problem_6 = false;                 ///< If true, runs problem 6.
@@ -17,6 +17,11 @@ struct Args
     int n_steps = 10;                           ///< Number of steps when running Jacobi's rotation method.
     int N_max = 100;                            ///< Number of different sizes for the matrix A in Jacobi's rotation method (problem 5).
     int maxiter = 10000;                        ///< Maximum number of iterations when running Jacobi's method.
+    std::string method = "jacobi";              ///< Eigensolver in problem 6: "jacobi", "parallel" (cyclic Jacobi, where maxiter is the maximum number of sweeps), "sturm" (bisection and inverse iteration) or "lanczos" (matrix-free, where maxiter is the maximum number of matrix-vector products).
+    int n_eigs = 0;                             ///< Number of (smallest) eigenpairs computed by "sturm" and "lanczos", and kept by the Jacobi methods, in problem 6, 0 for all.
+    int n_threads = 4;                          ///< Number of threads for the parallel eigensolvers, and for the matrix sizes in problem 5.
+    std::string trace = "";                     ///< If not empty, file to trace the convergence of Jacobi's rotation method to (one file per N in problem 5), binary if it ends with ".bin".
+    int trace_every = 1000;                     ///< Rotations between the samples of the trace.
 };
 
 
@@ -3,6 +3,8 @@
 
 #include <armadillo>
 #include "utils.hpp"
+#include "packed_symmetric.hpp"
+#include "jacobi_trace.hpp"
 
 /** @addtogroup StandAloneFunctions
  * @{
@@ -18,9 +20,27 @@
  */
 void jacobi_rotate(arma::mat &A, arma::mat &R, int k, int l);
 
+/**
+ * @brief Performs a single Jacobi rotation of a packed symmetric matrix, giving the same result as the full version.
+ *
+ * Only one copy of every element is updated. Elements above row \f$\min(k,l)\f$ lie in columns k and l
+ * and are updated by a contiguous two-column kernel, as are columns k and l of R.
+ *
+ * @param A The symmetric matrix to be diagonalized.
+ * @param R The matrix of eigenvectors.
+ * @param k The row index of the maximal off-diagonal element.
+ * @param l The column index of the maximal off-diagonal element.
+ */
+void jacobi_rotate(PackedSymmetricMatrix &A, arma::mat &R, int k, int l);
+
 /**
  * @brief Computes the eigenvalues and eigenvectors of a symmetric matrix using Jacobi's rotation method.
  *
+ * The matrix is rotated in packed form (see @ref PackedSymmetricMatrix), with the pivots found by @ref PivotCache.
+ * Both only touch the envelope of the rows, so a banded matrix is cheap until it has filled in.
+ * The eigenvectors are only needed at the end, so the rotations of them are saved and applied 64 at a time, a tile
+ * of rows at a time, which keeps the columns in cache between the rotations.
+ *
  * @param A The symmetric matrix to be diagonalized.
  * @param eps The convergence tolerance for the off-diagonal elements.
  * @param eigenvalues Vector to store the computed eigenvalues (output).
@@ -28,8 +48,27 @@ void jacobi_rotate(arma::mat &A, arma::mat &R, int k, int l);
  * @param maxiter The maximum number of iterations allowed.
  * @param iterations The number of iterations performed (output).
  * @param converged Boolean flag indicating whether the method converged (output).
+ * @param trace Where to record the convergence, see @ref JacobiTrace (none if null).
+ */
+void jacobi_eigensolver(const arma::mat &A, double eps, arma::vec &eigenvalues, arma::mat &eigenvectors, const int maxiter, int &iterations, bool &converged,
+                        JacobiTrace *trace = nullptr);
+
+/**
+ * @brief Computes only the eigenvalues of a symmetric matrix using Jacobi's rotation method.
+ *
+ * The rotations are the same as in the version with eigenvectors, but no matrix of eigenvectors is stored or rotated,
+ * which is about half of the work (and memory) when only the eigenvalues or the number of iterations are needed.
+ *
+ * @param A The symmetric matrix to be diagonalized.
+ * @param eps The convergence tolerance for the off-diagonal elements.
+ * @param eigenvalues Vector to store the computed eigenvalues (output).
+ * @param maxiter The maximum number of iterations allowed.
+ * @param iterations The number of iterations performed (output).
+ * @param converged Boolean flag indicating whether the method converged (output).
+ * @param trace Where to record the convergence, see @ref JacobiTrace (none if null).
  */
-void jacobi_eigensolver(const arma::mat &A, double eps, arma::vec &eigenvalues, arma::mat &eigenvectors, const int maxiter, int &iterations, bool &converged);
+void jacobi_eigensolver(const arma::mat &A, double eps, arma::vec &eigenvalues, const int maxiter, int &iterations, bool &converged,
+                        JacobiTrace *trace = nullptr);
 
 #endif
 
@@ -0,0 +1,63 @@
+#ifndef JACOBI_TRACE_HPP
+#define JACOBI_TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Records the convergence of Jacobi's rotation method while it runs, for profiling.
+ *
+ * Every @p every rotations (and after the last one) a sample is written with
+ *  - the number of rotations done,
+ *  - the elapsed time in seconds,
+ *  - the rotations per second since the previous sample,
+ *  - the off-diagonal Frobenius norm \f$\mathrm{off}(A) = (\sum_{i\neq j} a_{ij}^2)^{1/2}\f$,
+ *  - the greatest off-diagonal element (in absolute value), i.e. the next pivot.
+ *
+ * Two formats are supported, chosen by the file extension:
+ *  - `.bin`: Raw binary, one record per sample of a uint64 (rotations) followed by the four doubles, in native byte order.
+ *  - anything else: CSV with a header line.
+ *
+ * Computing off(A) takes \f$O(N^2)\f$ operations, so @p every should be at least about N to keep the
+ * overhead small. Without a trace (a null pointer) the solver only checks the pointer.
+ */
+class JacobiTrace{
+private:
+    std::ofstream file;
+    bool binary;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point last_time;
+    std::int64_t last_rotations = 0;
+
+public:
+    const int every;    ///< Rotations between the samples.
+
+    /**
+     * @brief Opens @p filename for writing, and starts the clock.
+     *
+     * @param filename Name of the trace file (binary if it ends with `.bin`).
+     * @param every Rotations between the samples.
+     */
+    JacobiTrace(const std::string &filename, int every);
+
+    /**
+     * @brief Writes a sample.
+     *
+     * @param rotations Number of rotations done.
+     * @param off_norm Off-diagonal Frobenius norm.
+     * @param max_offdiag Greatest off-diagonal element (in absolute value).
+     */
+    void record(std::int64_t rotations, double off_norm, double max_offdiag);
+};
+
+/**
+ * @brief Name of the trace file for the matrix of size N when several are traced, `<stem>_N<N><ext>`.
+ *
+ * @param filename Name given for the trace.
+ * @param N Matrix size.
+ */
+std::string trace_filename(const std::string &filename, int N);
+
+#endif
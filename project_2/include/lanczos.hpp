@@ -0,0 +1,82 @@
+#ifndef LANCZOS_HPP
+#define LANCZOS_HPP
+
+#include <armadillo>
+
+/**
+ * @brief A symmetric N x N matrix which is only known through its product with vectors, so that it does not have
+ * to be stored.
+ */
+class LinearOperator{
+public:
+    virtual ~LinearOperator(){}
+
+    /**
+     * @brief Size N of the (N x N) matrix.
+     */
+    virtual int size() const = 0;
+
+    /**
+     * @brief Computes \f$y = Ax\f$.
+     *
+     * @param x Vector of length N.
+     * @param y Vector of length N (output).
+     */
+    virtual void apply(const double *x, double *y) const = 0;
+};
+
+
+/**
+ * @brief Tridiagonal matrix with constant diagonals, as made by @ref utils::create_tridiagonal, but only storing
+ * the three values.
+ */
+class TridiagonalOperator : public LinearOperator{
+private:
+    int N;
+    double a, d, e;
+
+public:
+    /**
+     * @param N Size of the matrix.
+     * @param a Sub-diagonal elements.
+     * @param d Diagonal elements.
+     * @param e Super-diagonal elements.
+     */
+    TridiagonalOperator(int N, double a, double d, double e);
+
+    int size() const override;
+    void apply(const double *x, double *y) const override;
+};
+
+
+/** @addtogroup StandAloneFunctions
+ * @{
+ */
+
+/**
+ * @brief Computes the @p n_eigs smallest eigenvalues and their eigenvectors of a symmetric matrix, only using
+ * products with the matrix, by the thick-restart Lanczos method.
+ *
+ * A Krylov basis of m = min(N, 2 n_eigs + 20) vectors is built, orthogonalized in full against the basis (classical
+ * Gram-Schmidt, twice), and the Ritz pairs are found from the small projected matrix \f$V^TAV\f$. If they have not
+ * converged, the basis is restarted from the n_eigs + (m - n_eigs)/2 lowest Ritz vectors and the last Lanczos vector,
+ * and extended again. A Ritz pair \f$(\theta, y)\f$ has the residual \f$\|Ay - \theta y\| = |\beta_m s_m|\f$, where
+ * \f$s_m\f$ is the last element of its eigenvector of the projected matrix, so this is known without extra products.
+ *
+ * Only the m + 1 basis vectors of length N are stored, i.e. \f$O(n_{eigs} N)\f$ memory.
+ *
+ * @param A The symmetric matrix.
+ * @param n_eigs Number of eigenpairs to compute (the smallest ones).
+ * @param eps Convergence tolerance for the residuals, relative to the largest Ritz value (in absolute value).
+ * @param eigenvalues Vector to store the computed eigenvalues, in increasing order (output).
+ * @param eigenvectors Matrix to store the computed (normalized) eigenvectors as columns (output).
+ * @param maxiter The maximum number of products with A.
+ * @param iterations The number of products with A performed (output).
+ * @param converged Boolean flag indicating whether the method converged (output).
+ */
+void lanczos_eigensolver(const LinearOperator &A, int n_eigs, double eps, arma::vec &eigenvalues, arma::mat &eigenvectors,
+                         const int maxiter, int &iterations, bool &converged);
+
+/** @} */
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef PACKED_SYMMETRIC
+#define PACKED_SYMMETRIC
+#include <armadillo>
+#include <vector>
+
+
+/**
+ * @brief Symmetric matrix where only the upper triangular part is stored, column by column:
+ * \f[
+ * (a_{00}),\ (a_{01}, a_{11}),\ (a_{02}, a_{12}, a_{22}),\ \ldots
+ * \f]
+ * i.e. \f$N(N+1)/2\f$ elements instead of \f$N^2\f$, with element \f$(i,j), i\leq j\f$, at \f$j(j+1)/2 + i\f$.
+ *
+ * Column \f$j\f$ above the diagonal, which is also row \f$j\f$ below the diagonal, is then contiguous. Only one
+ * copy of every element has to be updated in a rotation, and the rows searched by @ref PivotCache are contiguous.
+ *
+ * For every row \f$i\f$ it also keeps the range [first_nonzero(i), last_nonzero(i)] (containing \f$i\f$) outside
+ * of which the row is zero, i.e. the envelope of the matrix. For a banded matrix this is the band, so the rotations
+ * and pivot searches can skip the zeros which have not yet been filled in. Whoever writes to the matrix must keep
+ * the envelope up to date with @ref fill_in.
+ */
+class PackedSymmetricMatrix{
+private:
+    int N;
+    std::vector<double> packed;
+    std::vector<int> first, last;   // Envelope of every row
+    int n_full;                     // Number of rows whose envelope is the whole row
+
+    bool full(int i) const{ return first[i] == 0 and last[i] == N - 1; }
+
+    static size_t offset(int j){ return (size_t)j * (j + 1) / 2; }
+
+public:
+    /**
+     * @brief Packs the symmetric matrix @p A.
+     *
+     * @param A Symmetric (square) matrix, of which only the lower triangular part is read.
+     */
+    PackedSymmetricMatrix(const arma::mat &A);
+
+    /**
+     * @brief Size N of the (N x N) matrix.
+     */
+    int size() const{ return N; }
+
+    /**
+     * @brief Element \f$(i,j)\f$, which is the same as \f$(j,i)\f$.
+     */
+    double &operator()(int i, int j){ return (i <= j) ? packed[offset(j) + i] : packed[offset(i) + j]; }
+    double operator()(int i, int j) const{ return (i <= j) ? packed[offset(j) + i] : packed[offset(i) + j]; }
+
+    /**
+     * @brief Pointer to column \f$j\f$ above (and including) the diagonal, i.e. elements \f$(0,j), \ldots, (j,j)\f$.
+     */
+    double *column(int j){ return packed.data() + offset(j); }
+    const double *column(int j) const{ return packed.data() + offset(j); }
+
+    /**
+     * @brief First column of row \f$i\f$ which may be nonzero (at most \f$i\f$).
+     */
+    int first_nonzero(int i) const{ return first[i]; }
+
+    /**
+     * @brief Last column of row \f$i\f$ which may be nonzero (at least \f$i\f$).
+     */
+    int last_nonzero(int i) const{ return last[i]; }
+
+    /**
+     * @brief Widens the envelope for a rotation in the \f$(k,l)\f$ plane, which mixes rows (and columns) k and l:
+     * both get the union of their ranges, and every row in it may get nonzeros in columns k and l.
+     * Takes \f$O(\text{width of the union})\f$ operations, and nothing once the matrix has filled in.
+     */
+    void fill_in(int k, int l);
+
+    /**
+     * @brief The diagonal.
+     */
+    arma::vec diag() const;
+
+    /**
+     * @brief Frobenius norm of the off-diagonal part, \f$(\sum_{i\neq j} a_{ij}^2)^{1/2}\f$.
+     */
+    double offdiag_norm() const;
+
+    /**
+     * @brief The full (N x N) matrix.
+     */
+    arma::mat unpack() const;
+};
+
+#endif
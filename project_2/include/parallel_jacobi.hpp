@@ -0,0 +1,38 @@
+#ifndef PARALLEL_JACOBI_HPP
+#define PARALLEL_JACOBI_HPP
+
+#include <armadillo>
+
+/** @addtogroup StandAloneFunctions
+ * @{
+ */
+
+/**
+ * @brief Computes the eigenvalues and eigenvectors of a symmetric matrix using the cyclic Jacobi method,
+ * with the rotations of each step applied in parallel.
+ *
+ * Instead of rotating away the greatest off-diagonal element one at a time, every pair \f$(k,l)\f$ is rotated
+ * once per sweep. The pairs are scheduled in round-robin (Brent-Luk) order: a sweep consists of \f$N-1\f$ steps
+ * of \f$N/2\f$ disjoint pairs, so the rotations of a step commute and can be applied at the same time. A step
+ * first updates columns \f$k\f$ and \f$l\f$ of A and R for every pair (split between the threads by pairs), and
+ * then rows \f$k\f$ and \f$l\f$ of A (split by columns, so every thread stays within its own columns).
+ *
+ * The threads are started once and kept for the whole solve, synchronizing with a barrier between the steps.
+ * Convergence is checked after every sweep, on the Frobenius norm of the off-diagonal part,
+ * \f$\mathrm{off}(A) = (\sum_{i\neq j} a_{ij}^2)^{1/2}\f$, which decreases quadratically once it is small.
+ *
+ * @param A The symmetric matrix to be diagonalized.
+ * @param eps The convergence tolerance for off(A).
+ * @param eigenvalues Vector to store the computed eigenvalues (output).
+ * @param eigenvectors Matrix to store the computed eigenvectors (output).
+ * @param maxsweeps The maximum number of sweeps allowed.
+ * @param sweeps The number of sweeps performed (output).
+ * @param converged Boolean flag indicating whether the method converged (output).
+ * @param n_threads Number of threads to use.
+ */
+void parallel_jacobi_eigensolver(const arma::mat &A, double eps, arma::vec &eigenvalues, arma::mat &eigenvectors,
+                                 const int maxsweeps, int &sweeps, bool &converged, int n_threads);
+
+/** @} */
+
+#endif
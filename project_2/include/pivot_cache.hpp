@@ -0,0 +1,66 @@
+#ifndef PIVOT_CACHE
+#define PIVOT_CACHE
+#include <armadillo>
+#include <vector>
+#include "packed_symmetric.hpp"
+
+
+/**
+ * @brief Keeps track of the greatest off-diagonal element (in absolute value) of a symmetric matrix
+ * while it is being rotated, so that it does not have to be searched for from scratch.
+ *
+ * For every row \f$i\f$ it stores the column of the greatest element \f$|A_{ij}|, j<i\f$, in the lower
+ * triangular part. A Jacobi rotation in the \f$(k,l)\f$ plane only changes rows and columns \f$k\f$ and \f$l\f$,
+ * so after a rotation rows \f$k\f$ and \f$l\f$ are searched again, while every other row only has its (one or two)
+ * changed elements compared to its maximum. A row is only searched again if its maximum got smaller.
+ * Finding the greatest element is then a search over the \f$N\f$ row maxima, i.e. \f$O(N)\f$ per rotation
+ * instead of the \f$O(N^2)\f$ of @ref max_offdiag_symmetric.
+ *
+ * For a PackedSymmetricMatrix, only the envelope of the rows is searched (see
+ * @ref PackedSymmetricMatrix::first_nonzero), so that a banded matrix costs \f$O(\text{bandwidth})\f$ per row
+ * until it has filled in.
+ *
+ * Ties are resolved as in @ref max_offdiag_symmetric (the first element in a row by row search of the
+ * lower triangular part), so the sequence of pivots, and hence of rotations, is exactly the same.
+ *
+ * @tparam Matrix arma::mat, or PackedSymmetricMatrix (where the rows searched are contiguous).
+ */
+template<class Matrix>
+class PivotCache{
+private:
+    int N;
+    std::vector<int> max_col;       // Column of the greatest |A(i,j)|, j<i, in row i
+    std::vector<double> max_abs;    // and its absolute value
+
+    void search_row(const Matrix &A, int i);                     // Searches row i from scratch
+    void update_element(const Matrix &A, int i, int j);          // Row i, where only A(i,j) has changed
+
+public:
+    /**
+     * @brief Searches every row of the lower triangular part of @p A.
+     *
+     * @param A Symmetric (square) matrix.
+     */
+    PivotCache(const Matrix &A);
+
+    /**
+     * @brief Updates the row maxima after a rotation in the \f$(k,l)\f$ plane.
+     *
+     * @param A The rotated matrix.
+     * @param k Row index of the rotation.
+     * @param l Column index of the rotation.
+     */
+    void update(const Matrix &A, int k, int l);
+
+    /**
+     * @brief Finds the greatest off-diagonal element (in absolute value), as @ref max_offdiag_symmetric.
+     *
+     * @param A The matrix the cache is kept for.
+     * @param k Row index (output, left unchanged if all off-diagonal elements are zero).
+     * @param l Column index (output, left unchanged if all off-diagonal elements are zero).
+     * @return Greatest off-diagonal element (in absolute value) of A.
+     */
+    double max(const Matrix &A, int &k, int &l) const;
+};
+
+#endif
@@ -7,23 +7,50 @@
  * using @ref triDag::create_tridiaginal and computing the eigenvalues using Jacobi's rotation method implemented in 
  * @ref jacobi_eigensolver::jacobi_eigensolver. Writes the result to @p outfile.
  * 
+ * The sizes are independent, so they are solved on @p n_threads threads, the largest first. The results are still
+ * written in order of N, stopping at the first N which did not converge. Every finished size is also appended to
+ * @p outfile + ".checkpoint", and a rerun (with the same tol and maxiter) skips the sizes found there.
+ * 
+ * If @p trace_file is not empty, the convergence for each size N is traced (see @ref JacobiTrace) to
+ * @ref trace_filename(trace_file, N).
+ * 
  * @param N_max     Final size of matrix.
  * @param tol       Tolerance passed to @ref jacobi_eigensolver::jacobi_eigensolver.
  * @param maxiter   Maximum number of iterations.
  * @param outfile   File to write results to.
+ * @param n_threads Number of threads.
+ * @param trace_file  File to trace the convergence to, none if empty.
+ * @param trace_every Rotations between the samples of the trace.
  */
-void problem_5(double N_max, double tol, int maxiter, const std::string &outfile);
+void problem_5(double N_max, double tol, int maxiter, const std::string &outfile, int n_threads = 1,
+               const std::string &trace_file = "", int trace_every = 1000);
 
 
 /**
  * @brief Creates a tridiagonal matrix using @ref triDag::create_tridiagonal, computes its eigenvalues and eigenvectors using Jacobi's
  * rotation method implemented in @ref jacobi_eigensolver::jacobi_eigensolver. Writes these eigenvalues and eigenvectors to @ref outfile
  * 
+ * With @p method "parallel", the parallel cyclic Jacobi method in @ref parallel_jacobi::parallel_jacobi_eigensolver is used
+ * instead, with "sturm" @ref tridiagonal_eigensolver::tridiagonal_eigensolver, which only stores the diagonals, and with
+ * "lanczos" @ref lanczos::lanczos_eigensolver, which only uses products with the matrix. The latter two can compute only
+ * the @p n_eigs smallest eigenpairs, and the Jacobi methods then only keep them (sorted by eigenvalue).
+ * 
+ * If @p outfile ends with ".bin", the shape (N and the number of eigenpairs, as uint64), the eigenvalues and the
+ * eigenvectors (column by column) are written as raw binary, which is much smaller and faster than the text for large N.
+ * 
+ * If @p trace_file is not empty, the convergence of the "jacobi" method is traced to it (see @ref JacobiTrace).
+ * 
  * @param n_steps   Number if steps for Jacobi's rotation method (1 - size of tridiagonal matrix).
  * @param tol       Tolerance passed to @ref jacobi_eigensolver::jacobi_eigensolver.
- * @param maxiter   Maximum number of iterations.
+ * @param maxiter   Maximum number of iterations (sweeps with "parallel").
  * @param outfile   File to write results to.
+ * @param method    Eigensolver: "jacobi", "parallel", "sturm" or "lanczos".
+ * @param n_threads Number of threads for the parallel eigensolvers.
+ * @param n_eigs    Number of (smallest) eigenpairs to compute or keep, 0 for all.
+ * @param trace_file  File to trace the convergence to, none if empty.
+ * @param trace_every Rotations between the samples of the trace.
  */
-void problem_6(int n_steps, double tol, int maxiter, const std::string &outfile);
+void problem_6(int n_steps, double tol, int maxiter, const std::string &outfile, const std::string &method = "jacobi", int n_threads = 1,
+               int n_eigs = 0, const std::string &trace_file = "", int trace_every = 1000);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef TRIDIAGONAL_EIGENSOLVER_HPP
+#define TRIDIAGONAL_EIGENSOLVER_HPP
+
+#include <armadillo>
+
+/** @addtogroup StandAloneFunctions
+ * @{
+ */
+
+/**
+ * @brief Counts the eigenvalues less than @p x of the symmetric tridiagonal matrix with diagonal @p d and
+ * off-diagonal @p e, from the signs of the pivots \f$q_i = d_i - x - e_{i-1}^2/q_{i-1}\f$ of \f$T - xI\f$ (Sturm sequence).
+ *
+ * @param d Diagonal (length N).
+ * @param e Off-diagonal (length N-1).
+ * @param x Where to count.
+ * @return Number of eigenvalues less than x.
+ */
+int sturm_count(const arma::vec &d, const arma::vec &e, double x);
+
+/**
+ * @brief Computes the @p n_eigs smallest eigenvalues and their eigenvectors of a symmetric tridiagonal matrix,
+ * storing only its two diagonals.
+ *
+ * The eigenvalues are found one by one by bisection of the Gershgorin interval with @ref sturm_count, until the
+ * interval is a few ulps wide (the accuracy is then limited by roundoff in the counts, about \f$\epsilon\|T\|\f$).
+ * Every count also narrows the intervals of the other eigenvalues, and four eigenvalues are bisected at a time in
+ * one pass over the matrix (the recurrences are independent, which hides the latency of the divisions). The
+ * eigenvalues are split between the threads.
+ *
+ * The eigenvectors are found by inverse iteration, i.e. by solving \f$(T - \lambda I) x_{new} = x\f$ a few times
+ * with the Thomas algorithm from project 1 (general_algorithm). Eigenvectors of eigenvalues closer than
+ * \f$\sqrt{\epsilon}\,\|T\|\f$ (where inverse iteration alone does not give orthogonal vectors) are orthogonalized
+ * against each other, so such clusters are handled by a single thread.
+ *
+ * Everything is \f$O(N)\f$ per eigenpair and there is no \f$N\times N\f$ matrix, so only @p n_eigs eigenvectors
+ * of length N are stored, e.g. the lowest ones for N = 1e5.
+ *
+ * @param d Diagonal (length N).
+ * @param e Off-diagonal (length N-1).
+ * @param n_eigs Number of eigenpairs to compute (the smallest ones).
+ * @param eigenvalues Vector to store the computed eigenvalues, in increasing order (output).
+ * @param eigenvectors Matrix to store the computed (normalized) eigenvectors as columns (output).
+ * @param n_threads Number of threads to use.
+ */
+void tridiagonal_eigensolver(const arma::vec &d, const arma::vec &e, int n_eigs,
+                             arma::vec &eigenvalues, arma::mat &eigenvectors, int n_threads = 1);
+
+/** @} */
+
+#endif
@@ -17,7 +17,7 @@ int main(int argc, char *argv[])
 
     if (args.run_problem_5)
     {
-        problem_5(args.N_max, args.tol, args.maxiter, args.outfile);
+        problem_5(args.N_max, args.tol, args.maxiter, args.outfile, args.n_threads, args.trace, args.trace_every);
         std::cout << "\nData for Problem 5 written to " << args.outfile << "\n";
     }
 
@@ -26,7 +26,8 @@ int main(int argc, char *argv[])
     // -------------
     if (args.run_problem_6)
     {
-        problem_6(args.n_steps, args.tol, args.maxiter, args.outfile);
+        problem_6(args.n_steps, args.tol, args.maxiter, args.outfile, args.method, args.n_threads, args.n_eigs, args.trace,
+                  args.trace_every);
         std::cout << "\nData for Problem 6 written to " << args.outfile << "\n";
     }
 
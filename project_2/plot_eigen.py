@@ -1,3 +1,4 @@
+import os
 import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
@@ -14,15 +15,29 @@ sol_anal[:, 2] = np.sin(3 * np.pi * x_anal)
 
 colors = ['C0', 'C1', 'C2']
 
+
+def read_eigen(n_steps):
+    """Reads the eigenvalues and eigenvectors (as columns) written by problem 6, from binary if it exists, else text."""
+    filename = f'output/eigen-n{n_steps}.bin'
+    if os.path.exists(filename):
+        with open(filename, 'rb') as infile:
+            N, m = (int(k) for k in np.fromfile(infile, dtype=np.uint64, count=2))
+            eig_vals = np.fromfile(infile, dtype=np.float64, count=m)
+            # Written column by column
+            eig_vecs = np.fromfile(infile, dtype=np.float64, count=N*m).reshape((N, m), order='F')
+            return eig_vals, eig_vecs
+
+    data = pd.read_csv(f'output/eigen-n{n_steps}.csv', sep=r'\s+', header=None).to_numpy()
+    return data[0, :], data[1:, :]
+
+
 fig, ax = plt.subplots(nrows=2, sharex=True, figsize=(6, 5))
 
 # Iterates over chosen n_steps, corresponding to the number of steps in Jacobi's rotation method
 for i, n_steps in enumerate([10, 100]):
 
     # Reads data
-    data = pd.read_csv(f'output/eigen-n{n_steps}.csv', sep=r'\s+', header=None).to_numpy()
-    eig_vals = data[0, :]
-    eig_vecs = data[1:, :]
+    eig_vals, eig_vecs = read_eigen(n_steps)
     
     N = eig_vecs.shape[0]
 
@@ -43,6 +43,34 @@ Args parse_args(int argc, char *argv[])
         {
             args.maxiter = std::stoi(argv[++i]);
         }
+        else if (arg == "--parallel")
+        {
+            args.method = "parallel";
+        }
+        else if (arg == "--sturm")
+        {
+            args.method = "sturm";
+        }
+        else if (arg == "--lanczos")
+        {
+            args.method = "lanczos";
+        }
+        else if (arg == "--n_eigs" && i + 1 < argc)
+        {
+            args.n_eigs = std::stoi(argv[++i]);
+        }
+        else if (arg == "--n_threads" && i + 1 < argc)
+        {
+            args.n_threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "--trace" && i + 1 < argc)
+        {
+            args.trace = argv[++i];
+        }
+        else if (arg == "--trace_every" && i + 1 < argc)
+        {
+            args.trace_every = std::stoi(argv[++i]);
+        }
         else
         {
             std::cerr << "Unknown argument: " << arg << "\n";
@@ -1,4 +1,7 @@
 #include "jacobi_eigensolver.hpp"
+#include "pivot_cache.hpp"
+
+#include <vector>
 
 void jacobi_rotate(arma::mat &A, arma::mat &R, int k, int l)
 {
@@ -58,6 +61,185 @@ void jacobi_rotate(arma::mat &A, arma::mat &R, int k, int l)
     }
 }
 
+namespace
+{
+    /**
+     * (x, y) = (x c - y s, y c + x s) for n contiguous elements, which the compiler vectorizes.
+     */
+    inline void rotate_pair(double *__restrict x, double *__restrict y, int n, double c, double s)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            double x_i = x[i];
+            double y_i = y[i];
+            x[i] = x_i * c - y_i * s;
+            y[i] = y_i * c + x_i * s;
+        }
+    }
+
+    /**
+     * The part of jacobi_rotate that updates A, giving the rotation (c, s) used.
+     */
+    void rotate_packed(PackedSymmetricMatrix &A, int k, int l, double &c, double &s)
+    {
+        double a_kk = A(k, k);
+        double a_ll = A(l, l);
+        double a_kl = A(k, l);
+
+        double t;
+        double tau = (a_ll - a_kk) / (2 * a_kl);
+
+        if (tau > 0)    // Smallest tau value will give faster convergence
+        {
+            t = 1.0 / (tau + std::sqrt(1 + tau * tau));
+        }
+        else
+        {
+            t = -1.0 / (-tau + std::sqrt(1 + tau * tau));
+        }
+
+        c = 1.0 / std::sqrt(1 + t * t);
+        s = c * t;
+
+        // Update A, where element (i,j), i<=j, is column(j)[i]
+
+        A(k, k) = a_kk * c * c - 2 * a_kl * c * s + a_ll * s * s;
+        A(l, l) = a_ll * c * c + 2 * a_kl * c * s + a_kk * s * s;
+        A(k, l) = 0;
+
+        // Rows k and l are zero outside the union of their envelopes, and rotating zeros gives zeros:
+        A.fill_in(k, l);
+        const int first = A.first_nonzero(k);
+        const int last = A.last_nonzero(k);
+
+        const int lo = std::min(k, l);
+        const int hi = std::max(k, l);
+        double *a_k = A.column(k);
+        double *a_l = A.column(l);
+
+        // Rows above both: (i,k) and (i,l) are in columns k and l
+        rotate_pair(a_k + first, a_l + first, lo - first, c, s);
+
+        // Rows in between: one element in column hi, the other in row lo of column i
+        for (int i = lo + 1; i < hi; i++)
+        {
+            double &a_ik = (k == hi) ? a_k[i] : A.column(i)[k];
+            double &a_il = (l == hi) ? a_l[i] : A.column(i)[l];
+            double a_ik_old = a_ik;
+            double a_il_old = a_il;
+
+            a_ik = a_ik_old * c - a_il_old * s;
+            a_il = a_il_old * c + a_ik_old * s;
+        }
+
+        // Rows below both: (k,i) and (l,i) are in column i
+        for (int i = hi + 1; i <= last; i++)
+        {
+            double *a_i = A.column(i);
+            double a_ik = a_i[k];
+            double a_il = a_i[l];
+
+            a_i[k] = a_ik * c - a_il * s;
+            a_i[l] = a_il * c + a_ik * s;
+        }
+    }
+
+    /**
+     * A rotation waiting to be applied to R.
+     */
+    struct Rotation
+    {
+        int k, l;
+        double c, s;
+    };
+
+    /**
+     * Applies the rotations (in order) to R, a tile of rows at a time, so that the columns used by the
+     * rotations stay in cache while all of them are applied, instead of R being streamed once per rotation.
+     */
+    void apply_rotations(arma::mat &R, const std::vector<Rotation> &rotations)
+    {
+        const int tile = 256;   // Rows, i.e. 2 kB per column
+        const int N = R.n_rows;
+        for (int first = 0; first < N; first += tile)
+        {
+            const int rows = std::min(tile, N - first);
+            for (const Rotation &r : rotations)
+            {
+                rotate_pair(R.colptr(r.k) + first, R.colptr(r.l) + first, rows, r.c, r.s);
+            }
+        }
+    }
+
+    /**
+     * Jacobi's rotation method, with or without (if R is null) the eigenvectors.
+     */
+    void jacobi(const arma::mat &A, double eps, arma::vec &eigenvalues, arma::mat *R, const int maxiter,
+                int &iterations, bool &converged, JacobiTrace *trace)
+    {
+        iterations = 0;
+
+        PackedSymmetricMatrix A_m(A); // Copy of A to be changed
+
+        // Same pivots as max_offdiag_symmetric, but only the rows changed by a rotation are searched again:
+        PivotCache<PackedSymmetricMatrix> pivots(A_m);
+
+        // The rotations of R are only needed at the end, so they are applied in groups:
+        const int group = 64;
+        std::vector<Rotation> rotations;
+        rotations.reserve(group);
+
+        int k, l;
+        double max_offdiag = pivots.max(A_m, k, l);
+
+        while (std::abs(max_offdiag) > eps and iterations < maxiter)
+        {
+            if (trace and iterations % trace->every == 0)
+            {
+                trace->record(iterations, A_m.offdiag_norm(), std::abs(max_offdiag));
+            }
+
+            double c, s;
+            rotate_packed(A_m, k, l, c, s);
+            if (R)
+            {
+                rotations.push_back({k, l, c, s});
+                if (rotations.size() == group)
+                {
+                    apply_rotations(*R, rotations);
+                    rotations.clear();
+                }
+            }
+            pivots.update(A_m, k, l);
+            max_offdiag = pivots.max(A_m, k, l);
+
+            iterations++;
+        }
+        if (R)
+        {
+            apply_rotations(*R, rotations);
+        }
+        if (trace)
+        {
+            trace->record(iterations, A_m.offdiag_norm(), std::abs(max_offdiag));
+        }
+
+        eigenvalues = A_m.diag();
+        // (The pivot can be negative, so it is its absolute value which must be below eps)
+        converged = (std::abs(max_offdiag) <= eps);
+    }
+}
+
+void jacobi_rotate(PackedSymmetricMatrix &A, arma::mat &R, int k, int l)
+{
+    double c, s;
+    rotate_packed(A, k, l, c, s);
+
+    // Update R
+
+    rotate_pair(R.colptr(k), R.colptr(l), R.n_rows, c, s);
+}
+
 void jacobi_eigensolver(
     const arma::mat &A, 
     double eps, 
@@ -66,26 +248,16 @@ void jacobi_eigensolver(
     arma::mat &eigenvectors, 
     const int maxiter, 
     int &iterations, 
-    bool &converged)
+    bool &converged,
+    JacobiTrace *trace)
 {  
-    iterations = 0;
-
-    arma::mat A_m = A; // Copy of A to be changed
     arma::mat R_m = arma::eye(A.n_rows, A.n_rows);
-
-    int k, l;
-    double max_offdiag = max_offdiag_symmetric(A_m, k, l);
-    
-    while (std::abs(max_offdiag) > eps and iterations < maxiter)
-    {
-        jacobi_rotate(A_m, R_m, k, l);
-        max_offdiag = max_offdiag_symmetric(A_m, k, l);
-
-        iterations++;
-    }
-
-    eigenvalues = A_m.diag();
+    jacobi(A, eps, eigenvalues, &R_m, maxiter, iterations, converged, trace);
     eigenvectors = R_m;
-    iterations = iterations;
-    converged = (max_offdiag <= eps);
-}
\ No newline at end of file
+}
+
+void jacobi_eigensolver(const arma::mat &A, double eps, arma::vec &eigenvalues, const int maxiter, int &iterations, bool &converged,
+                        JacobiTrace *trace)
+{
+    jacobi(A, eps, eigenvalues, nullptr, maxiter, iterations, converged, trace);
+}
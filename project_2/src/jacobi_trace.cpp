@@ -0,0 +1,45 @@
+#include "jacobi_trace.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+JacobiTrace::JacobiTrace(const std::string &filename, int every):
+    binary(filename.size() >= 4 and filename.compare(filename.size() - 4, 4, ".bin") == 0),
+    start(std::chrono::steady_clock::now()), last_time(start), every(std::max(every, 1)){
+
+    file.open(filename, binary ? std::ios::binary : std::ios::out);
+    if(not file){
+        throw std::runtime_error("JacobiTrace: Could not open " + filename);
+    }
+    if(not binary){
+        file << "rotations,elapsed,rotations_per_second,off_norm,max_offdiag\n";
+    }
+}
+
+void JacobiTrace::record(std::int64_t rotations, double off_norm, double max_offdiag){
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - start).count();
+    double interval = std::chrono::duration<double>(now - last_time).count();
+    double rate = (interval > 0) ? (rotations - last_rotations) / interval : 0;
+
+    last_time = now;
+    last_rotations = rotations;
+
+    if(binary){
+        double values[4] = {elapsed, rate, off_norm, max_offdiag};
+        file.write(reinterpret_cast<const char *>(&rotations), sizeof(rotations));
+        file.write(reinterpret_cast<const char *>(values), sizeof(values));
+    }
+    else{
+        file << rotations << "," << elapsed << "," << rate << "," << off_norm << "," << max_offdiag << "\n";
+    }
+}
+
+std::string trace_filename(const std::string &filename, int N){
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of("/\\");
+    if(dot == std::string::npos or (slash != std::string::npos and dot < slash)){
+        dot = filename.size();
+    }
+    return filename.substr(0, dot) + "_N" + std::to_string(N) + filename.substr(dot);
+}
@@ -0,0 +1,231 @@
+#include "lanczos.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+TridiagonalOperator::TridiagonalOperator(int N, double a, double d, double e):
+    N(N), a(a), d(d), e(e){
+}
+
+int TridiagonalOperator::size() const{
+    return N;
+}
+
+void TridiagonalOperator::apply(const double *x, double *y) const{
+    if(N == 1){
+        y[0] = d * x[0];
+        return;
+    }
+    y[0] = d * x[0] + e * x[1];
+    for(int i=1; i<N-1; i++){
+        y[i] = a * x[i-1] + d * x[i] + e * x[i+1];
+    }
+    y[N-1] = a * x[N-2] + d * x[N-1];
+}
+
+namespace
+{
+    double dot(const double *x, const double *y, int N)
+    {
+        double sum = 0;
+        for (int i = 0; i < N; i++)
+        {
+            sum += x[i] * y[i];
+        }
+        return sum;
+    }
+
+    /**
+     * Removes the components of w along the first n columns of V (classical Gram-Schmidt, done twice since once
+     * is not enough in floating point), and adds the coefficients removed to h.
+     */
+    void orthogonalize(const arma::mat &V, int n, double *w, double *h)
+    {
+        const int N = V.n_rows;
+        std::vector<double> c(n);
+
+        std::fill(h, h + n, 0.0);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                c[i] = dot(V.colptr(i), w, N);
+            }
+            for (int i = 0; i < n; i++)
+            {
+                const double *v = V.colptr(i);
+                for (int k = 0; k < N; k++)
+                {
+                    w[k] -= c[i] * v[k];
+                }
+                h[i] += c[i];
+            }
+        }
+    }
+
+    /**
+     * Normalized random vector, orthogonal to the first n columns of V.
+     */
+    void random_vector(const arma::mat &V, int n, double *w, std::mt19937 &generator)
+    {
+        const int N = V.n_rows;
+        std::uniform_real_distribution<double> uniform(-1, 1);
+        std::vector<double> h(n);
+
+        for (int k = 0; k < N; k++)
+        {
+            w[k] = uniform(generator);
+        }
+        orthogonalize(V, n, w, h.data());
+
+        const double norm = std::sqrt(dot(w, w, N));
+        for (int k = 0; k < N; k++)
+        {
+            w[k] /= norm;
+        }
+    }
+
+    /**
+     * Y = (first m columns of V) S, for the first columns of S.
+     */
+    arma::mat ritz_vectors(const arma::mat &V, const arma::mat &S, int m, int n_vectors)
+    {
+        const int N = V.n_rows;
+        arma::mat Y(N, n_vectors, arma::fill::zeros);
+        for (int j = 0; j < n_vectors; j++)
+        {
+            double *y = Y.colptr(j);
+            for (int i = 0; i < m; i++)
+            {
+                const double *v = V.colptr(i);
+                const double s = S(i, j);
+                for (int k = 0; k < N; k++)
+                {
+                    y[k] += s * v[k];
+                }
+            }
+        }
+        return Y;
+    }
+}
+
+void lanczos_eigensolver(const LinearOperator &A, int n_eigs, double eps, arma::vec &eigenvalues, arma::mat &eigenvectors,
+                         const int maxiter, int &iterations, bool &converged)
+{
+    const int N = A.size();
+    n_eigs = std::max(0, std::min(n_eigs, N));
+    const int m = std::min(N, 2 * n_eigs + 20);     // Size of the basis
+    const int keep = n_eigs + (m - n_eigs) / 2;     // Ritz vectors kept when restarting
+
+    iterations = 0;
+    converged = true;
+    eigenvalues.set_size(n_eigs);
+    eigenvectors.set_size(N, n_eigs);
+    if (n_eigs == 0)
+    {
+        return;
+    }
+
+    arma::mat V(N, m + 1, arma::fill::zeros);      // Basis, and the next Lanczos vector
+    arma::mat H(m, m, arma::fill::zeros);          // V^T A V
+    std::vector<double> h(m);
+    std::mt19937 generator(1);
+
+    arma::vec theta;
+    arma::mat S;
+
+    random_vector(V, 0, V.colptr(0), generator);
+
+    int p = 0;                  // Number of vectors kept from the last restart
+    double beta = 0;
+    double norm_estimate = 0;
+
+    while (true)
+    {
+        // Extend the basis to m vectors:
+        for (int j = p; j < m; j++)
+        {
+            double *w = V.colptr(j + 1);
+            A.apply(V.colptr(j), w);
+            iterations++;
+
+            orthogonalize(V, j + 1, w, h.data());
+            for (int i = 0; i <= j; i++)
+            {
+                H(i, j) = h[i];
+                H(j, i) = h[i];
+                norm_estimate = std::max(norm_estimate, std::abs(h[i]));
+            }
+
+            beta = std::sqrt(dot(w, w, N));
+            if (beta > std::numeric_limits<double>::epsilon() * norm_estimate)
+            {
+                for (int k = 0; k < N; k++)
+                {
+                    w[k] /= beta;
+                }
+            }
+            else if (j + 1 < m)
+            {
+                // Invariant subspace, continue with any new direction:
+                random_vector(V, j + 1, w, generator);
+            }
+            else
+            {
+                beta = 0;
+            }
+        }
+
+        if (m == N)
+        {
+            beta = 0;   // The basis spans everything, the rest is roundoff
+        }
+        arma::eig_sym(theta, S, H);
+
+        // Residuals of the Ritz pairs are |beta s_m|:
+        const double scale = std::max(std::abs(theta(0)), std::abs(theta(m - 1)));
+        converged = true;
+        for (int i = 0; i < n_eigs; i++)
+        {
+            if (std::abs(beta * S(m - 1, i)) > eps * scale)
+            {
+                converged = false;
+            }
+        }
+
+        if (converged or iterations >= maxiter)
+        {
+            break;
+        }
+
+        // Restart from the lowest Ritz vectors, followed by the last Lanczos vector:
+        arma::mat Y = ritz_vectors(V, S, m, keep);
+        std::copy(V.colptr(m), V.colptr(m) + N, V.colptr(keep));
+        std::copy(Y.memptr(), Y.memptr() + (size_t)N * keep, V.memptr());
+
+        H.zeros(m, m);
+        for (int i = 0; i < keep; i++)
+        {
+            H(i, i) = theta(i);
+        }
+        p = keep;
+    }
+
+    eigenvectors = ritz_vectors(V, S, m, n_eigs);
+    for (int j = 0; j < n_eigs; j++)
+    {
+        eigenvalues(j) = theta(j);
+
+        // Same sign convention as tridiagonal_eigensolver:
+        double *y = eigenvectors.colptr(j);
+        if (y[0] < 0)
+        {
+            for (int k = 0; k < N; k++)
+            {
+                y[k] = -y[k];
+            }
+        }
+    }
+}
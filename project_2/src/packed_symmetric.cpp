@@ -0,0 +1,79 @@
+#include "packed_symmetric.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+PackedSymmetricMatrix::PackedSymmetricMatrix(const arma::mat &A):
+    N(A.n_rows), packed(offset(A.n_rows)), first(N), last(N){
+    for(int j=0; j<N; j++){
+        first[j] = j;
+        last[j] = j;
+    }
+    for(int j=0; j<N; j++){
+        double *a_j = column(j);
+        for(int i=0; i<=j; i++){
+            a_j[i] = A(j,i);
+            if(a_j[i] != 0){
+                first[j] = std::min(first[j], i);
+                last[i] = std::max(last[i], j);
+            }
+        }
+    }
+    n_full = 0;
+    for(int j=0; j<N; j++){
+        n_full += full(j);
+    }
+}
+
+void PackedSymmetricMatrix::fill_in(int k, int l){
+    if(n_full == N){
+        return;
+    }
+    const int lo = std::min(first[k], first[l]);
+    const int hi = std::max(last[k], last[l]);
+    const int k_lo = std::min(k, l);
+    const int k_hi = std::max(k, l);
+    for(int i=lo; i<=hi; i++){
+        const bool was_full = full(i);
+        first[i] = std::min(first[i], k_lo);
+        last[i] = std::max(last[i], k_hi);
+        n_full += full(i) - was_full;
+    }
+    for(int i : {k, l}){
+        const bool was_full = full(i);
+        first[i] = lo;
+        last[i] = hi;
+        n_full += full(i) - was_full;
+    }
+}
+
+arma::vec PackedSymmetricMatrix::diag() const{
+    arma::vec d(N);
+    for(int j=0; j<N; j++){
+        d(j) = column(j)[j];
+    }
+    return d;
+}
+
+double PackedSymmetricMatrix::offdiag_norm() const{
+    double sum = 0;
+    for(int j=1; j<N; j++){
+        const double *a_j = column(j);
+        for(int i=first[j]; i<j; i++){
+            sum += a_j[i] * a_j[i];
+        }
+    }
+    return std::sqrt(2 * sum);
+}
+
+arma::mat PackedSymmetricMatrix::unpack() const{
+    arma::mat A(N, N);
+    for(int j=0; j<N; j++){
+        const double *a_j = column(j);
+        for(int i=0; i<=j; i++){
+            A(i,j) = a_j[i];
+            A(j,i) = a_j[i];
+        }
+    }
+    return A;
+}
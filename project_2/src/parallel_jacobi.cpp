@@ -0,0 +1,239 @@
+#include "parallel_jacobi.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /**
+     * Blocks the threads calling wait() until all n_threads of them have.
+     */
+    class Barrier
+    {
+    private:
+        std::mutex mutex;
+        std::condition_variable all_arrived;
+        int n_threads;
+        int waiting = 0;
+        long generation = 0;
+
+    public:
+        Barrier(int n_threads) : n_threads(n_threads) {}
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            long arrived_in = generation;
+            if (++waiting == n_threads)
+            {
+                waiting = 0;
+                generation++;
+                all_arrived.notify_all();
+            }
+            else
+            {
+                all_arrived.wait(lock, [&] { return generation != arrived_in; });
+            }
+        }
+    };
+
+    /**
+     * Rotation (as in jacobi_rotate) that zeroes a_kl.
+     */
+    void rotation_angle(double a_kk, double a_ll, double a_kl, double &c, double &s)
+    {
+        if (a_kl == 0)
+        {
+            c = 1;
+            s = 0;
+            return;
+        }
+
+        double tau = (a_ll - a_kk) / (2 * a_kl);
+        double t;
+        if (tau > 0)
+        {
+            t = 1.0 / (tau + std::sqrt(1 + tau * tau));
+        }
+        else
+        {
+            t = -1.0 / (-tau + std::sqrt(1 + tau * tau));
+        }
+
+        c = 1.0 / std::sqrt(1 + t * t);
+        s = c * t;
+    }
+
+    /**
+     * Columns k and l of the n x ? column-major matrix a, times the rotation.
+     */
+    void rotate_columns(double *a, int n, int k, int l, double c, double s)
+    {
+        double *a_k = a + (long)k * n;
+        double *a_l = a + (long)l * n;
+        for (int i = 0; i < n; i++)
+        {
+            double a_ik = a_k[i];
+            double a_il = a_l[i];
+            a_k[i] = a_ik * c - a_il * s;
+            a_l[i] = a_il * c + a_ik * s;
+        }
+    }
+}
+
+void parallel_jacobi_eigensolver(
+    const arma::mat &A,
+    double eps,
+    arma::vec &eigenvalues,
+    arma::mat &eigenvectors,
+    const int maxsweeps,
+    int &sweeps,
+    bool &converged,
+    int n_threads)
+{
+    const int N = A.n_rows;
+    const int m = N + N % 2;        // Round-robin needs an even number of players, index N (if odd) sits out
+    const int n_pairs = m / 2;
+    n_threads = std::max(1, std::min(n_threads, n_pairs));
+
+    arma::mat A_m = A; // Copy of A to be changed
+    arma::mat R_m = arma::eye(A.n_rows, A.n_rows);
+    double *a = A_m.memptr();
+    double *r = R_m.memptr();
+
+    std::vector<double> c(n_pairs), s(n_pairs);
+    std::vector<double> partial_off(n_threads);
+    Barrier barrier(n_threads);
+
+    sweeps = 0;
+    converged = false;
+
+    auto worker = [&](int thread)
+    {
+        const int pair_begin = thread * n_pairs / n_threads;
+        const int pair_end = (thread + 1) * n_pairs / n_threads;
+        const int col_begin = thread * N / n_threads;
+        const int col_end = (thread + 1) * N / n_threads;
+
+        // Every thread keeps its own copy of the schedule
+        std::vector<int> order(m);
+        for (int i = 0; i < m; i++)
+        {
+            order[i] = i;
+        }
+        std::vector<int> partner(m), pair_of(m);
+
+        for (int sweep = 0; ; sweep++)
+        {
+            // Off-diagonal norm, each thread summing over its own columns:
+            double off = 0;
+            for (int j = col_begin; j < col_end; j++)
+            {
+                const double *a_j = a + (long)j * N;
+                for (int i = 0; i < j; i++)
+                {
+                    off += a_j[i] * a_j[i];
+                }
+                for (int i = j + 1; i < N; i++)
+                {
+                    off += a_j[i] * a_j[i];
+                }
+            }
+            partial_off[thread] = off;
+            barrier.wait();
+
+            off = 0;
+            for (int t = 0; t < n_threads; t++)
+            {
+                off += partial_off[t];
+            }
+            // (All threads come to the same conclusion)
+            if (std::sqrt(off) <= eps or sweep == maxsweeps)
+            {
+                if (thread == 0)
+                {
+                    sweeps = sweep;
+                    converged = (std::sqrt(off) <= eps);
+                }
+                return;
+            }
+
+            for (int step = 0; step < m - 1; step++)
+            {
+                for (int p = 0; p < n_pairs; p++)
+                {
+                    partner[order[p]] = order[m - 1 - p];
+                    partner[order[m - 1 - p]] = order[p];
+                    pair_of[order[p]] = p;
+                    pair_of[order[m - 1 - p]] = p;
+                }
+
+                // Columns of A and R, for this thread's pairs:
+                for (int p = pair_begin; p < pair_end; p++)
+                {
+                    int k = order[p];
+                    int l = order[m - 1 - p];
+                    if (k == N or l == N)
+                    {
+                        c[p] = 1;
+                        s[p] = 0;
+                        continue;
+                    }
+
+                    rotation_angle(a[k + (long)k * N], a[l + (long)l * N], a[k + (long)l * N], c[p], s[p]);
+                    if (s[p] != 0)
+                    {
+                        rotate_columns(a, N, k, l, c[p], s[p]);
+                        rotate_columns(r, N, k, l, c[p], s[p]);
+                    }
+                }
+                barrier.wait();
+
+                // Rows of A, within this thread's columns:
+                for (int j = col_begin; j < col_end; j++)
+                {
+                    double *a_j = a + (long)j * N;
+                    for (int p = 0; p < n_pairs; p++)
+                    {
+                        if (s[p] == 0)
+                        {
+                            continue;
+                        }
+                        int k = order[p];
+                        int l = order[m - 1 - p];
+                        double a_kj = a_j[k];
+                        double a_lj = a_j[l];
+                        a_j[k] = a_kj * c[p] - a_lj * s[p];
+                        a_j[l] = a_lj * c[p] + a_kj * s[p];
+                    }
+                    // The rotated element is zero (up to roundoff):
+                    if (s[pair_of[j]] != 0)
+                    {
+                        a_j[partner[j]] = 0;
+                    }
+                }
+                barrier.wait();
+
+                // Next round: order[0] stays, the others move one place along
+                std::rotate(order.begin() + 1, order.end() - 1, order.end());
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads; t++)
+    {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    eigenvalues = A_m.diag();
+    eigenvectors = R_m;
+}
@@ -0,0 +1,99 @@
+#include "pivot_cache.hpp"
+
+namespace{
+    int matrix_size(const arma::mat &A){ return A.n_rows; }
+    int matrix_size(const PackedSymmetricMatrix &A){ return A.size(); }
+
+    // Range of row i which may be nonzero, only known for PackedSymmetricMatrix:
+    int first_nonzero(const arma::mat &, int){ return 0; }
+    int first_nonzero(const PackedSymmetricMatrix &A, int i){ return A.first_nonzero(i); }
+    int last_nonzero(const arma::mat &A, int){ return A.n_rows - 1; }
+    int last_nonzero(const PackedSymmetricMatrix &A, int i){ return A.last_nonzero(i); }
+}
+
+template<class Matrix>
+PivotCache<Matrix>::PivotCache(const Matrix &A):
+    N(matrix_size(A)), max_col(N, -1), max_abs(N, 0){
+    for(int i=1; i<N; i++){
+        search_row(A, i);
+    }
+}
+
+template<class Matrix>
+void PivotCache<Matrix>::search_row(const Matrix &A, int i){
+    max_col[i] = -1;
+    max_abs[i] = 0;
+    for(int j=first_nonzero(A, i); j<i; j++){
+        if(std::abs(A(i,j)) > max_abs[i]){
+            max_abs[i] = std::abs(A(i,j));
+            max_col[i] = j;
+        }
+    }
+}
+
+template<class Matrix>
+void PivotCache<Matrix>::update_element(const Matrix &A, int i, int j){
+    double value = std::abs(A(i,j));
+
+    if(max_col[i] == j){
+        // The maximum itself changed. If it grew it is still the first maximum, otherwise search again:
+        if(value >= max_abs[i]){
+            max_abs[i] = value;
+        }
+        else{
+            search_row(A, i);
+        }
+    }
+    else if(value > max_abs[i] or (value == max_abs[i] and value > 0 and j < max_col[i])){
+        max_abs[i] = value;
+        max_col[i] = j;
+    }
+}
+
+template<class Matrix>
+void PivotCache<Matrix>::update(const Matrix &A, int k, int l){
+    if(k < l){
+        std::swap(k, l);
+    }
+
+    // Rows k and l are entirely new:
+    search_row(A, l);
+    search_row(A, k);
+
+    // Rows below the envelope of row k (and l) are zero in columns k and l, before and after:
+    const int last = last_nonzero(A, k);
+    for(int i=l+1; i<=last; i++){
+        if(i == k){
+            continue;
+        }
+        if(i < k){
+            update_element(A, i, l);
+        }
+        else if(max_col[i] == k or max_col[i] == l){
+            // Two elements changed, one of them the maximum. Comparing one at a time would use the old maximum:
+            search_row(A, i);
+        }
+        else{
+            update_element(A, i, l);
+            update_element(A, i, k);
+        }
+    }
+}
+
+template<class Matrix>
+double PivotCache<Matrix>::max(const Matrix &A, int &k, int &l) const{
+    double max = 0;
+    double value = 0;
+    for(int i=1; i<N; i++){
+        if(max_abs[i] > max){ // First row with the greatest maximum, as in max_offdiag_symmetric
+            max = max_abs[i];
+            value = A(i, max_col[i]);
+            k = i; l = max_col[i];
+        }
+    }
+
+    return value;
+}
+
+template class PivotCache<arma::mat>;
+template class PivotCache<PackedSymmetricMatrix>;
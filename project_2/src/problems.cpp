@@ -1,66 +1,304 @@
 #include "problems.hpp"
 #include "jacobi_eigensolver.hpp"
+#include "parallel_jacobi.hpp"
+#include "tridiagonal_eigensolver.hpp"
+#include "lanczos.hpp"
+#include "jacobi_trace.hpp"
 #include "triDag.hpp"
 #include <armadillo>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
-void problem_5(double N_max, double tol, int maxiter, const std::string &outfile)
+namespace
 {
-    arma::mat A;
-    arma::vec eigvals;
-    arma::mat eigvecs;
+    /**
+     * Result of one matrix size in problem 5.
+     */
+    struct Problem5Result
+    {
+        int iterations;
+        bool converged;
+    };
 
-    int iterations;
-    bool converged;
+    /**
+     * Reads the sizes finished in an earlier run from the checkpoint file, if it was made with the same tol and maxiter.
+     * Lines cut short by a crash are skipped.
+     */
+    std::map<int, Problem5Result> read_checkpoint(const std::string &filename, const std::string &header)
+    {
+        std::map<int, Problem5Result> finished;
+        std::ifstream ifile(filename);
+
+        std::string line;
+        if (not std::getline(ifile, line) or line != header)
+        {
+            return finished;
+        }
+        while (std::getline(ifile, line))
+        {
+            int N, iterations, converged;
+            char comma_1, comma_2;
+            std::istringstream fields(line);
+            if (fields >> N >> comma_1 >> iterations >> comma_2 >> converged and comma_1 == ',' and comma_2 == ',')
+            {
+                finished[N] = {iterations, converged == 1};
+            }
+        }
+        return finished;
+    }
+
+    /**
+     * Writes the eigenvalues and the eigenvectors (as columns) in binary if the name ends with ".bin", and as text (the
+     * eigenvalues on the first line) otherwise. The binary file has the number of rows N and of eigenpairs m as two
+     * uint64, then the m eigenvalues and the N x m eigenvectors (column by column) as doubles.
+     */
+    void write_eigenpairs(const std::string &filename, const arma::vec &eigvals, const arma::mat &eigvecs)
+    {
+        const std::string bin = ".bin";
+        if (filename.size() >= bin.size() and filename.compare(filename.size() - bin.size(), bin.size(), bin) == 0)
+        {
+            const std::uint64_t shape[2] = {eigvecs.n_rows, eigvecs.n_cols};
+            std::ofstream ofile(filename, std::ios::binary);
+            ofile.write(reinterpret_cast<const char *>(shape), sizeof(shape));
+            ofile.write(reinterpret_cast<const char *>(eigvals.memptr()), eigvals.n_elem * sizeof(double));
+            ofile.write(reinterpret_cast<const char *>(eigvecs.memptr()), eigvecs.n_elem * sizeof(double));
+            ofile.close();
+            if (not ofile)
+            {
+                std::cout << "\nWarning: Could not write " << filename;
+            }
+            return;
+        }
+
+        std::ofstream ofile;
+        ofile.open(filename);
+        ofile << eigvals.t() << "\n"
+              << eigvecs;
+        ofile.close();
+    }
+
+    /**
+     * Opens a trace file, if a name is given. If it cannot be opened (e.g. the directory does not exist), a warning is
+     * printed and the solver runs without a trace, instead of the exception escaping (and, in a worker thread,
+     * terminating the program).
+     */
+    std::unique_ptr<JacobiTrace> open_trace(const std::string &filename, int every)
+    {
+        std::unique_ptr<JacobiTrace> trace;
+        if (filename.empty())
+        {
+            return trace;
+        }
+        try
+        {
+            trace.reset(new JacobiTrace(filename, every));
+        }
+        catch (const std::runtime_error &error)
+        {
+            std::cout << "\nWarning: " << error.what() << ", running without a trace\n";
+        }
+        return trace;
+    }
+}
+
+void problem_5(double N_max, double tol, int maxiter, const std::string &outfile, int n_threads,
+               const std::string &trace_file, int trace_every)
+{
+    // Sizes finished in an earlier run are read from the checkpoint, and every new one is appended to it:
+    const std::string checkpoint_file = outfile + ".checkpoint";
+    std::ostringstream header;
+    header << "# tol = " << std::setprecision(17) << tol << ", maxiter = " << maxiter;
+
+    std::map<int, Problem5Result> results = read_checkpoint(checkpoint_file, header.str());
+    std::ofstream checkpoint;
+    if (results.empty())
+    {
+        checkpoint.open(checkpoint_file);
+        checkpoint << header.str() << std::endl;
+    }
+    else
+    {
+        checkpoint.open(checkpoint_file, std::ios::app);
+        std::cout << "Skipping " << results.size() << " sizes finished in " << checkpoint_file << "\n";
+    }
+
+    // The largest (slowest) sizes first, so that no thread is left with a large one at the end:
+    std::vector<int> sizes;
+    for (int N = 5; N <= N_max; N += 5)
+    {
+        sizes.push_back(N);
+    }
+    std::vector<int> queue;
+    for (auto N = sizes.rbegin(); N != sizes.rend(); N++)
+    {
+        if (results.count(*N) == 0)
+        {
+            queue.push_back(*N);
+        }
+    }
 
     std::ofstream ofile;
     ofile.open(outfile);
 
-    // Write results for different N:
-    for (int N = 5; N <= N_max; N += 5)
+    std::mutex mutex;                   // For results, the files and the output below
+    std::atomic<int> next_in_queue(0);
+    int next_to_write = 0;              // Index in sizes
+    int N_failed = N_max + 1;           // Smallest size known (from this run or the checkpoint) not to converge
+    for (const auto &result : results)
     {
-        std::cout << "\rProcessing N = " << N << std::flush;
+        if (not result.second.converged)
+        {
+            N_failed = std::min(N_failed, result.first);
+        }
+    }
 
-        double h = 1.0 / (N + 1);
-        double d = 2 / (h * h);
-        double a = -1 / (h * h);
-        A = create_tridiagonal(N, a, d, a);
+    // Writes the results that are ready in order, up to and including the first size that did not converge:
+    auto write_in_order = [&]()
+    {
+        while (next_to_write < (int)sizes.size() and sizes[next_to_write] <= N_failed and results.count(sizes[next_to_write]))
+        {
+            int N = sizes[next_to_write];
+            ofile << N << "," << results[N].iterations << "," << results[N].converged << "\n";
+            ofile.flush();
+            next_to_write++;
+        }
+    };
 
-        jacobi_eigensolver(A, tol, eigvals, eigvecs, maxiter, iterations, converged);
-        ofile << N << "," << iterations << "," << converged << "\n";
+    auto worker = [&]()
+    {
+        arma::mat A;
+        arma::vec eigvals;
 
-        // Stop if convergence not reached:
-        if (not converged)
+        for (int q = next_in_queue++; q < (int)queue.size(); q = next_in_queue++)
         {
-            std::cout << "\nWarning: did not converge for N = " << N << ", terminating...\n";
-            break;
+            int N = queue[q];
+            std::unique_ptr<JacobiTrace> trace;
+            {
+                // Larger sizes will not converge either. (The largest sizes are solved first, so this mainly
+                // skips the sizes above a failure found in the checkpoint.)
+                std::lock_guard<std::mutex> lock(mutex);
+                if (N > N_failed)
+                {
+                    continue;
+                }
+                trace = open_trace(trace_file.empty() ? "" : trace_filename(trace_file, N), trace_every);
+            }
+
+            double h = 1.0 / (N + 1);
+            double d = 2 / (h * h);
+            double a = -1 / (h * h);
+            A = create_tridiagonal(N, a, d, a);
+
+            int iterations;
+            bool converged;
+            jacobi_eigensolver(A, tol, eigvals, maxiter, iterations, converged, trace.get());   // (only the iterations are needed)
+
+            std::lock_guard<std::mutex> lock(mutex);
+            results[N] = {iterations, converged};
+            if (not converged)
+            {
+                N_failed = std::min(N_failed, N);
+            }
+            checkpoint << N << "," << iterations << "," << converged << std::endl;
+
+            std::cout << "\rProcessing, finished N = " << N << "        " << std::flush;
+            write_in_order();
         }
+    };
+
+    write_in_order();
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < n_threads; t++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Stop if convergence not reached:
+    if (N_failed <= N_max)
+    {
+        std::cout << "\nWarning: did not converge for N = " << N_failed << ", terminating...\n";
     }
     ofile.close();
 }
 
-void problem_6(int n_steps, double tol, int maxiter, const std::string &outfile)
+void problem_6(int n_steps, double tol, int maxiter, const std::string &outfile, const std::string &method, int n_threads, int n_eigs,
+               const std::string &trace_file, int trace_every)
 {
     int N = n_steps - 1;
     double h = 1.0 / n_steps;
     double d = 2 / (h * h);
     double a = -1 / (h * h);
 
-    arma::mat A = create_tridiagonal(N, a, d, a);
     arma::vec eigvals;
     arma::mat eigvecs;
 
     int iterations;
     bool converged;
 
-    jacobi_eigensolver(A, tol, eigvals, eigvecs, maxiter, iterations, converged);
+    // The Jacobi methods always compute all eigenpairs, so they are only sorted and cut if n_eigs is given:
+    const bool keep_lowest = (n_eigs > 0 and n_eigs < N);
+    if (n_eigs <= 0)
+    {
+        n_eigs = N;
+    }
+
+    if (method == "sturm")
+    {
+        // Only the diagonals are needed:
+        arma::vec diagonal(N);
+        arma::vec offdiagonal(N - 1);
+        diagonal.fill(d);
+        offdiagonal.fill(a);
+
+        tridiagonal_eigensolver(diagonal, offdiagonal, n_eigs, eigvals, eigvecs, n_threads);
+        converged = true;
+    }
+    else if (method == "lanczos")
+    {
+        TridiagonalOperator A(N, a, d, a);
+        lanczos_eigensolver(A, n_eigs, tol, eigvals, eigvecs, maxiter, iterations, converged);
+    }
+    else
+    {
+        arma::mat A = create_tridiagonal(N, a, d, a);
+
+        if (method == "parallel")
+        {
+            parallel_jacobi_eigensolver(A, tol, eigvals, eigvecs, maxiter, iterations, converged, n_threads);
+        }
+        else
+        {
+            std::unique_ptr<JacobiTrace> trace = open_trace(trace_file, trace_every);
+            jacobi_eigensolver(A, tol, eigvals, eigvecs, maxiter, iterations, converged, trace.get());
+        }
+
+        if (keep_lowest)
+        {
+            arma::uvec lowest = arma::sort_index(eigvals);
+            lowest.resize(n_eigs);
+            eigvals = eigvals.elem(lowest);
+            eigvecs = eigvecs.cols(lowest);
+        }
+    }
 
     if (not converged)
     {
         std::cout << "\nWarning: Solver did not converge";
     }
-    std::ofstream ofile;
-    ofile.open(outfile);
-    ofile << eigvals.t() << "\n"
-          << eigvecs;
-    ofile.close();
+    write_eigenpairs(outfile, eigvals, eigvecs);
 }
\ No newline at end of file
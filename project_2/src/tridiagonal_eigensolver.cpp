@@ -0,0 +1,296 @@
+#include "tridiagonal_eigensolver.hpp"
+#include "tridiagonal_algorithms.hpp"   // Thomas algorithm, from project 1
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    /**
+     * Calls function(begin, end) for n items split into one contiguous range per thread.
+     */
+    template <class Function>
+    void for_each_block(int n, int n_threads, Function function)
+    {
+        n_threads = std::max(1, std::min(n_threads, n));
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < n_threads; t++)
+        {
+            threads.emplace_back(function, t * n / n_threads, (t + 1) * n / n_threads);
+        }
+        function(0, n / n_threads);
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    /**
+     * Smallest pivot allowed in the Sturm sequence (smaller ones are replaced by -pivmin, as in LAPACK).
+     */
+    double smallest_pivot(const std::vector<double> &e2)
+    {
+        double max_e2 = 1;
+        for (double x : e2)
+        {
+            max_e2 = std::max(max_e2, x);
+        }
+        return std::numeric_limits<double>::min() * max_e2;
+    }
+
+    /**
+     * Sturm counts at lanes points at once, with independent recurrences so that the divisions overlap.
+     */
+    constexpr int lanes = 4;
+
+    void sturm_counts(const double *d, const double *e2, int N, double pivmin, const double *x, int *count)
+    {
+        double q[lanes];
+        int c[lanes];
+        for (int l = 0; l < lanes; l++)
+        {
+            q[l] = d[0] - x[l];
+            q[l] = (std::abs(q[l]) <= pivmin) ? -pivmin : q[l];
+            c[l] = (q[l] < 0);
+        }
+        for (int i = 1; i < N; i++)
+        {
+            for (int l = 0; l < lanes; l++)
+            {
+                q[l] = d[i] - x[l] - e2[i - 1] / q[l];
+                q[l] = (std::abs(q[l]) <= pivmin) ? -pivmin : q[l];
+                c[l] += (q[l] < 0);
+            }
+        }
+        for (int l = 0; l < lanes; l++)
+        {
+            count[l] = c[l];
+        }
+    }
+
+    /**
+     * Bisection for eigenvalues number begin, ..., end - 1 (counting from the smallest), starting from [gl, gu].
+     */
+    void bisect(const arma::vec &d, const std::vector<double> &e2, double pivmin, double gl, double gu,
+                int begin, int end, double *eigenvalues)
+    {
+        const int N = d.n_elem;
+        std::vector<double> lower(end - begin, gl), upper(end - begin, gu);
+
+        for (int first = begin; first < end; first += lanes)
+        {
+            const int width = std::min(lanes, end - first);
+            double x[lanes];
+            int count[lanes];
+
+            while (true)
+            {
+                bool done = true;
+                for (int l = 0; l < lanes; l++)
+                {
+                    const int j = first + std::min(l, width - 1) - begin;
+                    x[l] = 0.5 * (lower[j] + upper[j]);
+
+                    const double width_allowed = 2 * eps * std::max(std::abs(lower[j]), std::abs(upper[j])) + pivmin;
+                    if (upper[j] - lower[j] > width_allowed and x[l] > lower[j] and x[l] < upper[j])
+                    {
+                        done = false;
+                    }
+                }
+                if (done)
+                {
+                    break;
+                }
+
+                sturm_counts(d.memptr(), e2.data(), N, pivmin, x, count);
+
+                // Every count narrows the interval of every eigenvalue left in the block:
+                for (int l = 0; l < width; l++)
+                {
+                    for (int j = first - begin; j < end - begin; j++)
+                    {
+                        if (count[l] > j + begin)
+                        {
+                            upper[j] = std::min(upper[j], x[l]);
+                        }
+                        else
+                        {
+                            lower[j] = std::max(lower[j], x[l]);
+                        }
+                    }
+                }
+            }
+
+            for (int l = 0; l < width; l++)
+            {
+                const int j = first + l - begin;
+                eigenvalues[first + l] = 0.5 * (lower[j] + upper[j]);
+            }
+        }
+    }
+
+    /**
+     * Inverse iteration for the eigenvectors of eigenvalues number begin, ..., end - 1, which form a cluster
+     * (every vector is orthogonalized against the previous ones).
+     */
+    void inverse_iteration(const arma::vec &d, const arma::vec &e, double tnorm, const arma::vec &eigenvalues,
+                           int begin, int end, arma::mat &eigenvectors)
+    {
+        const int N = d.n_elem;
+        const int iterations = 2;
+        std::vector<double> b_shift(N), b_tilde(N);
+
+        for (int k = begin; k < end; k++)
+        {
+            double *x = eigenvectors.colptr(k);
+            double shift = eigenvalues(k);
+
+            for (int attempt = 0; ; attempt++)
+            {
+                std::mt19937 generator(k);
+                std::uniform_real_distribution<double> uniform(-1, 1);
+                for (int i = 0; i < N; i++)
+                {
+                    x[i] = uniform(generator);
+                    b_shift[i] = d(i) - shift;
+                }
+
+                double norm = 0;
+                for (int it = 0; it < iterations; it++)
+                {
+                    general_algorithm(e.memptr(), b_shift.data(), e.memptr(), x, N, b_tilde.data());
+
+                    for (int j = begin; j < k; j++)
+                    {
+                        const double *v = eigenvectors.colptr(j);
+                        double dot = 0;
+                        for (int i = 0; i < N; i++)
+                        {
+                            dot += v[i] * x[i];
+                        }
+                        for (int i = 0; i < N; i++)
+                        {
+                            x[i] -= dot * v[i];
+                        }
+                    }
+
+                    norm = 0;
+                    for (int i = 0; i < N; i++)
+                    {
+                        norm += x[i] * x[i];
+                    }
+                    norm = std::sqrt(norm);
+                    for (int i = 0; i < N; i++)
+                    {
+                        x[i] /= norm;
+                    }
+                }
+
+                if (std::isfinite(norm) and norm > 0)
+                {
+                    break;
+                }
+                // A zero pivot in the Thomas algorithm, move the shift slightly:
+                shift += eps * tnorm * (1 << std::min(attempt, 20));
+            }
+
+            if (x[0] < 0)
+            {
+                for (int i = 0; i < N; i++)
+                {
+                    x[i] = -x[i];
+                }
+            }
+        }
+    }
+}
+
+int sturm_count(const arma::vec &d, const arma::vec &e, double x)
+{
+    const int N = d.n_elem;
+    std::vector<double> e2(std::max(N - 1, 0));
+    for (int i = 0; i < N - 1; i++)
+    {
+        e2[i] = e(i) * e(i);
+    }
+    const double pivmin = smallest_pivot(e2);
+
+    double q = d(0) - x;
+    q = (std::abs(q) <= pivmin) ? -pivmin : q;
+    int count = (q < 0);
+    for (int i = 1; i < N; i++)
+    {
+        q = d(i) - x - e2[i - 1] / q;
+        q = (std::abs(q) <= pivmin) ? -pivmin : q;
+        count += (q < 0);
+    }
+    return count;
+}
+
+void tridiagonal_eigensolver(const arma::vec &d, const arma::vec &e, int n_eigs,
+                             arma::vec &eigenvalues, arma::mat &eigenvectors, int n_threads)
+{
+    const int N = d.n_elem;
+    n_eigs = std::max(0, std::min(n_eigs, N));
+
+    eigenvalues.set_size(n_eigs);
+    eigenvectors.set_size(N, n_eigs);
+    if (n_eigs == 0)
+    {
+        return;
+    }
+    if (N == 1)
+    {
+        eigenvalues(0) = d(0);
+        eigenvectors(0, 0) = 1;
+        return;
+    }
+
+    std::vector<double> e2(N - 1);
+    for (int i = 0; i < N - 1; i++)
+    {
+        e2[i] = e(i) * e(i);
+    }
+    const double pivmin = smallest_pivot(e2);
+
+    // Gershgorin interval, widened slightly for roundoff in the Sturm counts:
+    double gl = d(0);
+    double gu = d(0);
+    for (int i = 0; i < N; i++)
+    {
+        double radius = ((i > 0) ? std::abs(e(i - 1)) : 0) + ((i < N - 1) ? std::abs(e(i)) : 0);
+        gl = std::min(gl, d(i) - radius);
+        gu = std::max(gu, d(i) + radius);
+    }
+    const double tnorm = std::max(std::abs(gl), std::abs(gu));
+    gl -= 2 * eps * tnorm * N + 2 * pivmin;
+    gu += 2 * eps * tnorm * N + 2 * pivmin;
+
+    for_each_block(n_eigs, n_threads, [&](int begin, int end) {
+        bisect(d, e2, pivmin, gl, gu, begin, end, eigenvalues.memptr());
+    });
+
+    // Clusters of eigenvalues too close for inverse iteration alone to give orthogonal vectors:
+    std::vector<int> cluster_begin = {0};
+    for (int k = 1; k < n_eigs; k++)
+    {
+        if (eigenvalues(k) - eigenvalues(k - 1) > std::sqrt(eps) * tnorm)
+        {
+            cluster_begin.push_back(k);
+        }
+    }
+    cluster_begin.push_back(n_eigs);
+
+    for_each_block(cluster_begin.size() - 1, n_threads, [&](int begin, int end) {
+        for (int c = begin; c < end; c++)
+        {
+            inverse_iteration(d, e, tnorm, eigenvalues, cluster_begin[c], cluster_begin[c + 1], eigenvectors);
+        }
+    });
+}
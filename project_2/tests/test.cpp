@@ -1,8 +1,15 @@
 #include "utils.hpp"
 #include "triDag.hpp"
 #include "jacobi_eigensolver.hpp"
+#include "pivot_cache.hpp"
+#include "parallel_jacobi.hpp"
+#include "tridiagonal_eigensolver.hpp"
+#include "lanczos.hpp"
+#include "jacobi_trace.hpp"
 #include "utils.hpp"
 #include <cassert>
+#include <cstdio>
+#include <sstream>
 
 /**
  * @defgroup Tests Tests
@@ -63,6 +70,162 @@ int test_max_offdiag_symmetric(){
     return 0;
 }
 
+/**
+ * @brief Tests that @ref PivotCache gives the same pivots as @ref utils::max_offdiag_symmetric during a sequence of
+ * Jacobi rotations, for a matrix with many equal elements (so that the order of ties matters).
+ */
+int test_pivot_cache(){
+    int N = 12;
+    arma::mat A(N, N, arma::fill::zeros);
+    for(int i=0; i<N; i++){
+        A(i,i) = i;
+        for(int j=0; j<i; j++){
+            A(i,j) = (7*i + 3*j) % 5 - 2;
+            A(j,i) = A(i,j);
+        }
+    }
+    arma::mat R = arma::eye(N, N);
+
+    PivotCache pivots(A);
+
+    for(int it=0; it<200; it++){
+        int k, l, k_cached, l_cached;
+        double value = max_offdiag_symmetric(A, k, l);
+        double value_cached = pivots.max(A, k_cached, l_cached);
+
+        assert(value == value_cached);
+        assert(k == k_cached); assert(l == l_cached);
+
+        jacobi_rotate(A, R, k, l);
+        pivots.update(A, k, l);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Tests that a Jacobi rotation of a @ref PackedSymmetricMatrix gives exactly the same matrix as the
+ * full version, for rotations with both k > l and k < l.
+ */
+int test_packed_jacobi_rotate(){
+    int N = 9;
+    arma::mat A(N, N, arma::fill::zeros);
+    for(int i=0; i<N; i++){
+        A(i,i) = i;
+        for(int j=0; j<i; j++){
+            A(i,j) = std::sin(i + 2.*j);
+            A(j,i) = A(i,j);
+        }
+    }
+    arma::mat R = arma::eye(N, N);
+
+    PackedSymmetricMatrix A_packed(A);
+    arma::mat R_packed = arma::eye(N, N);
+
+    int rotations[4][2] = {{6, 2}, {1, 7}, {8, 0}, {3, 4}};
+    for(auto &kl : rotations){
+        jacobi_rotate(A, R, kl[0], kl[1]);
+        jacobi_rotate(A_packed, R_packed, kl[0], kl[1]);
+    }
+
+    assert(arma::approx_equal(A, A_packed.unpack(), "absdiff", 0));
+    assert(arma::approx_equal(R, R_packed, "absdiff", 0));
+
+    return 0;
+}
+
+/**
+ * @brief Tests that Jacobi rotations of a banded @ref PackedSymmetricMatrix, which only rotate and search the
+ * envelope, give exactly the same pivots and matrices as the full version while the band fills in, and that the
+ * full matrix is zero outside the envelope.
+ */
+int test_packed_fill_in(){
+    int N = 15;
+    arma::mat A(N, N, arma::fill::zeros);
+    for(int i=0; i<N; i++){
+        A(i,i) = 4 + std::cos(i);
+        for(int j=std::max(0, i-2); j<i; j++){
+            A(i,j) = std::sin(i + 2.*j);
+            A(j,i) = A(i,j);
+        }
+    }
+    arma::mat R = arma::eye(N, N);
+
+    PackedSymmetricMatrix A_packed(A);
+    arma::mat R_packed = arma::eye(N, N);
+    PivotCache<PackedSymmetricMatrix> pivots(A_packed);
+
+    for(int it=0; it<100; it++){
+        int k, l, k_packed, l_packed;
+        double value = max_offdiag_symmetric(A, k, l);
+        double value_packed = pivots.max(A_packed, k_packed, l_packed);
+
+        assert(value == value_packed);
+        assert(k == k_packed); assert(l == l_packed);
+
+        jacobi_rotate(A, R, k, l);
+        jacobi_rotate(A_packed, R_packed, k, l);
+        pivots.update(A_packed, k, l);
+
+        for(int i=0; i<N; i++){
+            for(int j=0; j<N; j++){
+                if(j < A_packed.first_nonzero(i) or j > A_packed.last_nonzero(i)){
+                    assert(A(i,j) == 0);
+                }
+            }
+        }
+    }
+
+    assert(arma::approx_equal(A, A_packed.unpack(), "absdiff", 0));
+    assert(arma::approx_equal(R, R_packed, "absdiff", 0));
+
+    return 0;
+}
+
+/**
+ * @brief Asserts that the computed eigenpairs are the smallest ones (as many as computed) of the tridiagonal
+ * matrix with @p a on the off-diagonals and @p d on the diagonal, given by @ref analytic_solution. The order of
+ * the computed eigenpairs, and the signs of the eigenvectors, do not matter.
+ *
+ * @param computed_vals Computed eigenvalues.
+ * @param computed_vecs Computed (normalized) eigenvectors, as columns.
+ * @param a Off-diagonal elements.
+ * @param d Diagonal elements.
+ * @param N Size of the matrix.
+ * @param val_tol Tolerance for the eigenvalues, relative to the eigenvalue.
+ * @param vec_tol Tolerance for the elements of the eigenvectors.
+ */
+void assert_analytic_eigenpairs(const arma::vec &computed_vals, const arma::mat &computed_vecs, double a, double d, int N,
+                                double val_tol, double vec_tol)
+{
+    arma::vec expected_vals;
+    arma::mat expected_vecs;
+    analytic_solution(expected_vals, expected_vecs, a, d, N);
+
+    // analytic_solution normalizes the eigenvalues, and their norm is the Frobenius norm of the matrix:
+    for (int j = 0; j < N; j++)
+    {
+        expected_vals(j) *= std::sqrt(N * d * d + 2 * (N - 1) * a * a);
+    }
+
+    // To compare eigenvalues/vectors, sort by eigenvalue:
+    arma::uvec expected_idx = arma::sort_index(expected_vals);
+    arma::uvec computed_idx = arma::sort_index(computed_vals);
+
+    for (int j = 0; j < (int)computed_vals.n_elem; j++)
+    {
+        double expected_val = expected_vals(expected_idx[j]);
+        assert(std::abs(computed_vals(computed_idx[j]) - expected_val) < val_tol * std::abs(expected_val));
+
+        // Equal up to a sign difference:
+        arma::vec expected_vec = expected_vecs.col(expected_idx[j]);
+        arma::vec computed_vec = computed_vecs.col(computed_idx[j]);
+        bool equal = arma::approx_equal(expected_vec, computed_vec, "absdiff", vec_tol);
+        bool mirrored = arma::approx_equal(expected_vec, -computed_vec, "absdiff", vec_tol);
+        assert(equal or mirrored);
+    }
+}
+
 /**
  * @brief Tests the implementation of Jacobi's iteration method in @ref jacobi_eigensolver.
  * 
@@ -77,11 +240,7 @@ int test_jacobi()
     double a = -1 / (h * h);
     arma::mat A = create_tridiagonal(N, a, d, a);
 
-    // Compute eigenvectors and eigenvalues analytically and numerically:
-    arma::vec expected_vals;
-    arma::mat expected_vecs;
-    analytic_solution(expected_vals, expected_vecs, a, d, N);
-
+    // Compute eigenvectors and eigenvalues numerically:
     arma::mat computed_vecs;
     arma::vec computed_vals;
 
@@ -91,40 +250,184 @@ int test_jacobi()
 
     jacobi_eigensolver(A, 1e-8, computed_vals, computed_vecs, maxiter, iterations, converged);
 
-    // To compare eigenvalues/vectors, sort by eigenvalue:
-    arma::uvec sort_idx;
+    // Without eigenvectors, the rotations (and so the eigenvalues) are exactly the same:
+    arma::vec computed_vals_only;
+    int iterations_only;
+    bool converged_only;
+    jacobi_eigensolver(A, 1e-8, computed_vals_only, maxiter, iterations_only, converged_only);
+
+    assert(iterations_only == iterations);
+    assert(converged_only == converged);
+    assert(arma::approx_equal(computed_vals_only, computed_vals, "absdiff", 0));
+
+    // Compare with the analytic solution:
+    assert_analytic_eigenpairs(computed_vals, computed_vecs, a, d, N, 1e-10, 1e-10);
+    return 0;
+}
+
+/**
+ * @brief Tests the parallel cyclic Jacobi method in @ref parallel_jacobi against the analytic solution, for an odd
+ * matrix size (so that one index sits out every step) and more than one thread.
+ */
+int test_parallel_jacobi()
+{
+    int N = 7;
+    double h = 1.0 / (N + 1);
+    double d = 2 / (h * h);
+    double a = -1 / (h * h);
+    arma::mat A = create_tridiagonal(N, a, d, a);
+
+    arma::vec computed_vals;
+    arma::mat computed_vecs;
+    int sweeps;
+    bool converged;
+
+    parallel_jacobi_eigensolver(A, 1e-8, computed_vals, computed_vecs, 100, sweeps, converged, 3);
+    assert(converged);
+
+    assert_analytic_eigenpairs(computed_vals, computed_vecs, a, d, N, 1e-10, 1e-10);
+    return 0;
+}
+
+/**
+ * @brief Tests the Sturm bisection and inverse iteration in @ref tridiagonal_eigensolver against the analytic
+ * solution, for all eigenpairs of a small matrix and the lowest ones of a large matrix.
+ */
+int test_tridiagonal_eigensolver()
+{
+    for (int N : {7, 2000})
+    {
+        double h = 1.0 / (N + 1);
+        double d = 2 / (h * h);
+        double a = -1 / (h * h);
+        arma::vec diagonal(N); diagonal.fill(d);
+        arma::vec offdiagonal(N - 1); offdiagonal.fill(a);
+
+        int n_eigs = std::min(N, 4);
+        arma::vec computed_vals;
+        arma::mat computed_vecs;
+        tridiagonal_eigensolver(diagonal, offdiagonal, n_eigs, computed_vals, computed_vecs, 2);
+
+        assert(sturm_count(diagonal, offdiagonal, computed_vals(0) * (1 - 1e-10)) == 0);
+        assert(sturm_count(diagonal, offdiagonal, computed_vals(0) * (1 + 1e-10)) == 1);
+
+        assert_analytic_eigenpairs(computed_vals, computed_vecs, a, d, N, 1e-10, 1e-8);
 
-    sort_idx = arma::sort_index(expected_vals);
-    expected_vals = expected_vals.elem(sort_idx);
-    expected_vecs = expected_vecs.cols(sort_idx);
+        // Sorted, and with a positive first element:
+        for (int j = 0; j < n_eigs; j++)
+        {
+            assert(j == 0 or computed_vals(j) > computed_vals(j - 1));
+            assert(computed_vecs(0, j) > 0);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Tests the matrix-free Lanczos method in @ref lanczos against the analytic solution, for the three lowest
+ * eigenpairs (which needs restarts) and for all of them (where the basis spans everything).
+ */
+int test_lanczos()
+{
+    for (int N : {100, 9})
+    {
+        double h = 1.0 / (N + 1);
+        double d = 2 / (h * h);
+        double a = -1 / (h * h);
+        TridiagonalOperator A(N, a, d, a);
+
+        int n_eigs = std::min(N, 3);
+        arma::vec computed_vals;
+        arma::mat computed_vecs;
+        int iterations;
+        bool converged;
+        lanczos_eigensolver(A, n_eigs, 1e-12, computed_vals, computed_vecs, 10000, iterations, converged);
+        assert(converged);
+
+        assert_analytic_eigenpairs(computed_vals, computed_vecs, a, d, N, 1e-10, 1e-8);
+
+        // Sorted, and with a positive first element as in tridiagonal_eigensolver:
+        for (int j = 0; j < n_eigs; j++)
+        {
+            assert(j == 0 or computed_vals(j) > computed_vals(j - 1));
+            assert(computed_vecs(0, j) > 0);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Tests the convergence trace in @ref jacobi_trace: the samples are taken every few rotations and after the
+ * last one, off(A) starts at its exact value and decreases, and tracing does not change the rotations.
+ */
+int test_jacobi_trace()
+{
+    assert(trace_filename("build/trace.csv", 20) == "build/trace_N20.csv");
+    assert(trace_filename("../trace", 5) == "../trace_N5");
 
-    sort_idx = arma::sort_index(computed_vals);
-    computed_vals = computed_vals.elem(sort_idx);
-    computed_vecs = computed_vecs.cols(sort_idx);
+    int N = 10;
+    double h = 1.0 / (N + 1);
+    double d = 2 / (h * h);
+    double a = -1 / (h * h);
+    arma::mat A = create_tridiagonal(N, a, d, a);
 
-    // Check equality.
-    double tol = 1e-10;
-    bool passed = true;
+    const std::string filename = "build/test_trace.csv";
+    const int every = 7;
 
-    if (not arma::approx_equal(expected_vals, computed_vals, "absdiff", tol))
+    arma::vec traced_vals, vals;
+    int traced_iterations, iterations;
+    bool converged;
     {
-        passed = false;
+        JacobiTrace trace(filename, every);
+        jacobi_eigensolver(A, 1e-10, traced_vals, 1000, traced_iterations, converged, &trace);
     }
+    jacobi_eigensolver(A, 1e-10, vals, 1000, iterations, converged);
 
-    for (int i = 0; i < N; i++)
+    assert(traced_iterations == iterations);
+    assert(arma::approx_equal(traced_vals, vals, "absdiff", 0));
+
+    std::ifstream ifile(filename);
+    std::string line;
+    std::getline(ifile, line);
+    assert(line == "rotations,elapsed,rotations_per_second,off_norm,max_offdiag");
+
+    std::vector<long> rotations;
+    std::vector<double> off_norms;
+    while (std::getline(ifile, line))
     {
-        // Check equality, up to a sign difference
-        // (assumes eigenvectors are normalized)
-        bool equal = arma::approx_equal(expected_vecs.col(i), computed_vecs.col(i), "absdiff", tol);
-        bool mirrored = arma::approx_equal(expected_vecs.col(i), -computed_vecs.col(i), "absdiff", tol);
-        
-        assert(equal or mirrored);
+        std::istringstream fields(line);
+        long n;
+        double elapsed, rate, off_norm, max_offdiag;
+        char comma;
+        fields >> n >> comma >> elapsed >> comma >> rate >> comma >> off_norm >> comma >> max_offdiag;
+        assert(max_offdiag <= off_norm);
+        rotations.push_back(n);
+        off_norms.push_back(off_norm);
     }
+
+    assert((int)rotations.size() == (iterations + every - 1) / every + 1);
+    assert(rotations.back() == iterations);
+    assert(std::abs(off_norms[0] - std::sqrt(2.0 * (N - 1)) * std::abs(a)) < 1e-5 * std::abs(a));   // (6 digits in the file)
+    for (int i = 1; i < (int)off_norms.size(); i++)
+    {
+        assert(rotations[i] - rotations[i - 1] <= every);
+        assert(off_norms[i] <= off_norms[i - 1]);
+    }
+
+    ifile.close();
+    std::remove(filename.c_str());
     return 0;
 }
 
 int main(){
     test_TriDag();
     test_max_offdiag_symmetric();
+    test_pivot_cache();
+    test_packed_jacobi_rotate();
+    test_packed_fill_in();
     test_jacobi();
+    test_parallel_jacobi();
+    test_tridiagonal_eigensolver();
+    test_lanczos();
+    test_jacobi_trace();
 }
\ No newline at end of file